@@ -53,6 +53,8 @@ const DCfont TinyOLED4kfont16x16cn = {
   16, // character width in pixels
   2, // character height in pages (8 pixels)
   48,52, // ASCII extents
-  0,0,0 // Unused for fixed width fonts
+  0,0,0, // Unused for fixed width fonts
+  0, // no offsets
+  0 // not compressed
   };
 
@@ -66,6 +66,8 @@ const DCfont cp_437_box_drawing_font = {
   8, // character width in pixels
   1, // character height in pages (8 pixels)
   175,223, // ASCII extents
-  0,0,0 // Unused for fixed width fonts
+  0,0,0, // Unused for fixed width fonts
+  0, // no offsets
+  0 // not compressed
   };
 
@@ -38,7 +38,8 @@
 const char textToScrollData[] PROGMEM = { "This is an example of scrolling text. " };
 DATACUTE_F_MACRO_T * textToScroll = FPSTR(textToScrollData);
 
-uint16_t nextRowOfTextToDraw;
+// The marquee keeps track of the next column of the text to draw.
+DCMarquee marquee;
 
 void setup() {
   oled.begin();
@@ -63,12 +64,10 @@ void setup() {
   // so the display should be set up, rather than just cleared, before turing on
   setupInitialDisplay();
 
-  // If the text to scroll needs to start on-screen, it can be initialized,
-  // clipped to the scrolling window
+  // The marquee starts at the cursor, is 118 pixels wide, and as high as the font.
+  // The text is drawn on-screen, clipped to the scrolling window.
   oled.setCursor(5, 1);
-  // Start drawing the text from the beginning pixel, clip at 118 pixels.
-  oled.clipText(0, 118, textToScroll);
-  nextRowOfTextToDraw = 118;
+  oled.startMarquee(&marquee, textToScroll, 118);
 
   oled.on();
 }
@@ -77,8 +76,8 @@ void loop() {
   // Content scrolling is controlled by the microcontroller.
   // Each request to scroll content results in the content shifting one pixel left or right
 
-  // The parameters are start page, end page, start column, end column
-  oled.scrollContentLeft(1, 2, 5, 122);
+  // The marquee scrolls the pages and columns it was started with
+  oled.scrollMarquee(&marquee);
 
   // However the scroll happens after the command is given, and a delay is required before
   // the edge of the scrolled content can be safely overwritten.
@@ -90,17 +89,9 @@ void loop() {
   // The default refresh rate for a 128x64 screen is 107.8 Hz, requiring a delay of 18.6ms
   delay(10);
 
-  // Draw one column of the text at the right hand end of the scrolling window.
-  oled.setCursor(122, 1);
-  oled.clipText(nextRowOfTextToDraw++, 1, textToScroll);
-
-  // Wrap the text...
-  // sizeof(textToScrollData) is 1 byte longer than the text
-  // (in includes the end of string marker)
-  // The font width is 8 pixels
-  if (nextRowOfTextToDraw >= (sizeof(textToScrollData) - 1) * 8) {
-    nextRowOfTextToDraw = 0;
-  }
+  // Draw the next column of the text at the right hand end of the scrolling window.
+  // The marquee wraps back to the start of the text after its end.
+  oled.drawMarquee(&marquee);
 
   // Fastest scrolling speed is slightly too quick, lets add another delay:
   delay(20);
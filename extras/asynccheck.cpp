@@ -0,0 +1,143 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks the asynchronous transfer queue, using a simulated interrupt source
+ * that feeds the emulator one bus event each time it fires.
+ * The same drawing is done with the queue drained as soon as anything is queued,
+ * and then with the interrupts firing at random points, so that the queue fills,
+ * and the engine often runs out of bytes part way through a transaction.
+ * The bus events, the GDDRAM, and the points at which the callbacks are called, must all match.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/asynccheck.cpp src/Tiny4kOLED.cpp -o asynccheck
+ * A smaller ring, e.g. -DTINY4KOLED_ASYNC_QUEUE_LENGTH=4, fills more often.
+ */
+#include <stdlib.h>
+
+static void simulated_interrupt(void);
+
+#define TINY4KOLED_EMULATOR_NO_DEVICE
+#define TINY4KOLED_ASYNC_ENGINE
+#define TINY4KOLED_ASYNC_WAIT() simulated_interrupt()
+#include "Tiny4kOLED_emulator.h"
+#include "Tiny4kOLED_async.h"
+#include "check.h"
+
+typedef struct Run {
+	uint32_t events;
+	uint32_t hash;
+	uint32_t callbacks[8];
+	uint8_t callbackCount;
+	uint8_t ram[8][128];
+} Run;
+
+static Run run;
+static uint8_t maxInterruptsPerKick; // 0 to drain the queue each time it is kicked
+
+static void simulated_interrupt(void) {
+	if (!tiny4koled_async.running) return;
+	uint8_t byte = 0;
+	uint8_t event = tiny4koled_async_next(&byte);
+	if (event == TINY4KOLED_ASYNC_NONE) return;
+	run.events++;
+	run.hash = run.hash * 31 + ((uint16_t)event << 8 | byte);
+	switch (event) {
+		case TINY4KOLED_ASYNC_START:
+			tiny4koled_beginTransmission_emulator();
+			break;
+		case TINY4KOLED_ASYNC_BYTE:
+			datacute_write_emulator(byte);
+			break;
+		default:
+			datacute_endTransmission_emulator();
+			if (!tiny4koled_async_pending()) tiny4koled_async.running = false;
+			break;
+	}
+}
+
+static void tiny4koled_async_engine_begin(void) {
+	tiny4koled_begin_emulator();
+	tiny4koled_emulator.bufferLength = 0;
+}
+
+static void tiny4koled_async_engine_kick(void) {
+	tiny4koled_async.running = true;
+	uint16_t interrupts = maxInterruptsPerKick ? rand() % (maxInterruptsPerKick + 1) : 0xFFFF;
+	while (interrupts-- && tiny4koled_async.running) {
+		simulated_interrupt();
+	}
+}
+
+static void completed(void) {
+	if (run.callbackCount < 8) run.callbacks[run.callbackCount] = run.events;
+	run.callbackCount++;
+}
+
+static const uint8_t pattern[] PROGMEM = {
+	0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0x00
+};
+
+static uint8_t frame[2 * 128];
+
+static void draw(void) {
+	memset(&run, 0, sizeof(run));
+	memset(tiny4koled_emulator.ram, 0, sizeof(tiny4koled_emulator.ram));
+	beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	oled.on();
+	oled.fill(0x55);
+	oled.onComplete(completed);
+	oled.clear();
+	oled.setFont(FONT8X16);
+	oled.setCursor(0, 0);
+	writeText("Queued 123");
+	oled.onComplete(completed);
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	oled.setFontX2Smooth(FONT6X8);
+	oled.setCursor(4, 2);
+	writeText("x2");
+#endif
+	oled.setFont(FONT6X8);
+	oled.setCursor(0, 5);
+	oled.drawString(F("drawString"));
+	oled.bitmap(100, 4, 116, 5, pattern);
+	oled.onComplete(completed);
+	DCFrameBuffer fb = {};
+	fb.buffer = frame;
+	fb.firstPage = 6;
+	fb.pages = 2;
+	oled.setFrameBuffer(&fb);
+	oled.setCursor(8, 6);
+	writeText("from RAM");
+	oled.flush();
+	oled.setFrameBuffer(0);
+	oled.onComplete(completed);
+	oled.waitIdle();
+	memcpy(run.ram, tiny4koled_emulator.ram, sizeof(run.ram));
+}
+
+static bool same(const Run &a, const Run &b) {
+	return a.events == b.events && a.hash == b.hash && a.callbackCount == b.callbackCount &&
+		memcmp(a.callbacks, b.callbacks, sizeof(a.callbacks)) == 0 && memcmp(a.ram, b.ram, sizeof(a.ram)) == 0;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	maxInterruptsPerKick = 0;
+	draw();
+	Run reference = run;
+	printf("%u bus events, %u callbacks\n", reference.events, reference.callbackCount);
+	for (uint16_t seed = 1; seed <= 200; seed++) {
+		srand(seed);
+		maxInterruptsPerKick = 1 + seed % 8;
+		draw();
+		if (!same(run, reference)) {
+			printf("seed %u differs\n", seed);
+			failures++;
+		}
+	}
+	printf("%u runs differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks bitmapCompressed, which decodes a compressed bitmap straight into a horizontal addressing window.
+ * The bitmap below has each kind of token, including back references that start part way into a run of
+ * zeros or cross into the next token, and zero runs long enough to be skipped that wrap to the next row.
+ * It is decoded here, as extras/bitmapcompress.py does, and drawn with bitmap at several positions and in
+ * both render frames of a 128x32 display. bitmapCompressed must change the same GDDRAM. When transparent, it must leave
+ * some zeros unsent, and change nothing but the bytes it does send.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/bitmapcheck.cpp src/Tiny4kOLED.cpp -o bitmapcheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+#define WIDTH 40
+#define PAGES 3
+
+static const uint8_t compressed[] PROGMEM = {
+	WIDTH, PAGES,
+	0x07, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, // 0: 8 literal bytes
+	0x44, 0xFF,                                           // 9: 6 x 0xFF
+	0x80, 0x1D,                                           // 11: 30 zeros, into the second row
+	0xC4, 0x00, 0x00,                                     // 13: 8 bytes from offset 0
+	0x01, 0x3C, 0x66,                                     // 16: 2 literal bytes
+	0xC0, 0x00, 0x0B,                                     // 19: the first 4 of the 30 zeros
+	0x80, 0x02,                                           // 22: 3 zeros
+	0x4A, 0x81,                                           // 24: 12 x 0x81
+	0x80, 0x1F,                                           // 26: 32 zeros, into the third row
+	0xC6, 0x00, 0x09,                                     // 28: 10 bytes from offset 9, the 0xFF run then 4 zeros
+	0x03, 0x11, 0x22, 0x33, 0x44,                         // 31: 4 literal bytes
+	0x00, 0x99,                                           // 36: 1 literal byte
+};
+
+static uint8_t plain[WIDTH * PAGES];
+static uint8_t expected[8][128];
+
+// Decodes size bytes from the token at offset i.
+static void decompress(const uint8_t *tokens, uint16_t i, uint8_t *out, uint16_t size) {
+	while (size) {
+		uint8_t kind = tokens[i] & 0xC0, n = tokens[i] & 0x3F;
+		uint16_t count;
+		if (kind == 0x00) {
+			count = n + 1;
+		} else if (kind == 0x40) {
+			count = n + 2;
+		} else if (kind == 0x80) {
+			count = (((uint16_t)n << 8) | tokens[i + 1]) + 1;
+		} else {
+			count = n + 4;
+		}
+		if (count > size) count = size;
+		if (kind == 0x00) {
+			memcpy(out, &tokens[i + 1], count);
+			i += 2 + n;
+		} else if (kind == 0x40) {
+			memset(out, tokens[i + 1], count);
+			i += 2;
+		} else if (kind == 0x80) {
+			memset(out, 0, count);
+			i += 2;
+		} else {
+			decompress(tokens, ((uint16_t)tokens[i + 1] << 8) | tokens[i + 2], out, count);
+			i += 3;
+		}
+		out += count;
+		size -= count;
+	}
+}
+
+static uint16_t checkPosition(uint8_t x, uint8_t y) {
+	uint16_t failures = 0;
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.bitmap(x, y, x + WIDTH, y + PAGES, plain);
+	memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.bitmapCompressed(x, y, compressed);
+	if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+		printf("bitmapCompressed at %u, %u differs\n", x, y);
+		failures++;
+	}
+
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.bitmapCompressed(x, y, compressed, true);
+	uint16_t unsent = 0;
+	for (uint8_t page = 0; page < 8; page++) {
+		for (uint8_t col = 0; col < 128; col++) {
+			uint8_t shown = tiny4koled_emulator.ram[page][col];
+			if (shown == expected[page][col]) continue;
+			if (shown == 0x5A && expected[page][col] == 0) {
+				unsent++;
+				continue;
+			}
+			printf("transparent bitmapCompressed at %u, %u differs at page %u column %u\n", x, y, page, col);
+			failures++;
+			page = 8;
+			break;
+		}
+	}
+	if (unsent < 24 * 2) {
+		printf("transparent bitmapCompressed at %u, %u only skipped %u zeros\n", x, y, unsent);
+		failures++;
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 32, sizeof(tiny4koled_init_128x32), tiny4koled_init_128x32)) return skipped("as it needs a 128x32 display");
+	decompress(compressed + 2, 0, plain, sizeof(plain));
+	for (uint8_t frame = 0; frame < 2; frame++) {
+		failures += checkPosition(0, 0);
+		failures += checkPosition(13, 1);
+		failures += checkPosition(88, 1);
+		oled.switchRenderFrame();
+	}
+	printf("%u bitmaps differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+#
+# Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+#
+# Converts an image into a compressed bitmap for oled.bitmapCompressed().
+#
+# Usage: bitmapcompress.py image name
+#
+# PBM images (P1 and P4) are read directly. Other formats, such as PNG, are read
+# using the Python Imaging Library (Pillow) when it is installed, with dark pixels
+# off and light pixels on. The image height is rounded up to a whole number of
+# pages. The printed array starts with the width in pixels and height in pages,
+# followed by the tokens described in Tiny4kOLED.cpp.
+#
+
+import sys
+
+MAX_LITERAL = 64
+MAX_RUN = 65
+MAX_ZEROS = 16384
+MIN_REFERENCE = 4
+MAX_REFERENCE = 67
+
+def pbm_tokens(data):
+    tokens = []
+    i = 0
+    while i < len(data):
+        if data[i:i + 1] == b'#':
+            while i < len(data) and data[i:i + 1] not in (b'\n', b'\r'):
+                i += 1
+        elif data[i:i + 1].isspace():
+            i += 1
+        else:
+            start = i
+            while i < len(data) and not data[i:i + 1].isspace() and data[i:i + 1] != b'#':
+                i += 1
+            tokens.append((data[start:i], i))
+    return tokens
+
+def read_pbm(data):
+    tokens = pbm_tokens(data[:64])
+    magic = tokens[0][0]
+    width, height = int(tokens[1][0]), int(tokens[2][0])
+    if magic == b'P4':
+        raster = data[tokens[2][1] + 1:]
+        stride = (width + 7) // 8
+        return width, height, lambda x, y: (raster[y * stride + x // 8] >> (7 - x % 8)) & 1
+    if magic == b'P1':
+        bits = [c for c in data[tokens[2][1]:].decode('ascii') if c in '01']
+        return width, height, lambda x, y: int(bits[y * width + x])
+    sys.exit('unsupported PBM type')
+
+def read_image(path):
+    data = open(path, 'rb').read()
+    if data[:2] in (b'P1', b'P4'):
+        # in a PBM, 1 is black, which is drawn as a lit pixel
+        return read_pbm(data)
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit('reading %s needs Pillow, or convert it to PBM' % path)
+    image = Image.open(path).convert('L')
+    return image.width, image.height, lambda x, y: 1 if image.getpixel((x, y)) >= 128 else 0
+
+def pages_of(width, height, pixel):
+    pages = (height + 7) // 8
+    out = []
+    for page in range(pages):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and pixel(x, y):
+                    byte |= 1 << bit
+            out.append(byte)
+    return pages, out
+
+def run_length(data, i):
+    j = i
+    while j < len(data) and data[j] == data[i]:
+        j += 1
+    return j - i
+
+def compress(data):
+    out = []
+    literal = []
+    # (offset in out, position in data, bytes decoded before the next back reference) of each non reference token
+    targets = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_LITERAL]
+            del literal[:MAX_LITERAL]
+            targets.append([len(out), position - len(literal) - len(chunk), len(chunk)])
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    def extend_targets(count):
+        for target in targets:
+            if target[1] + target[2] == position:
+                target[2] += count
+
+    position = 0
+    while position < len(data):
+        run = run_length(data, position)
+        best_length, best_offset = 0, 0
+        for offset, start, available in targets:
+            if offset > 0xFFFF:
+                break
+            length = 0
+            limit = min(available, MAX_REFERENCE, len(data) - position)
+            while length < limit and data[start + length] == data[position + length]:
+                length += 1
+            if length > best_length:
+                best_length, best_offset = length, offset
+        if data[position] == 0 and run >= 3 and run >= best_length:
+            flush_literal()
+            run = min(run, MAX_ZEROS)
+            extend_targets(run)
+            targets.append([len(out), position, run])
+            out.extend([0x80 | ((run - 1) >> 8), (run - 1) & 0xFF])
+            position += run
+        elif run >= 3 and run >= best_length:
+            flush_literal()
+            run = min(run, MAX_RUN)
+            extend_targets(run)
+            targets.append([len(out), position, run])
+            out.extend([0x40 | (run - 2), data[position]])
+            position += run
+        elif best_length >= MIN_REFERENCE:
+            flush_literal()
+            out.extend([0xC0 | (best_length - MIN_REFERENCE), best_offset >> 8, best_offset & 0xFF])
+            position += best_length
+        else:
+            extend_targets(1)
+            literal.append(data[position])
+            position += 1
+    flush_literal()
+    return out
+
+def decompress(tokens, i, size):
+    out = []
+    while len(out) < size:
+        kind, n = tokens[i] & 0xC0, tokens[i] & 0x3F
+        if kind == 0x00:
+            out.extend(tokens[i + 1:i + 2 + n])
+            i += 2 + n
+        elif kind == 0x40:
+            out.extend([tokens[i + 1]] * (n + 2))
+            i += 2
+        elif kind == 0x80:
+            out.extend([0] * (((n << 8) | tokens[i + 1]) + 1))
+            i += 2
+        else:
+            out.extend(decompress(tokens, (tokens[i + 1] << 8) | tokens[i + 2], n + MIN_REFERENCE))
+            i += 3
+    return out[:size]
+
+def main(path, name):
+    width, height, pixel = read_image(path)
+    if width > 128 or height > 64:
+        sys.exit('the image is larger than the display')
+    pages, data = pages_of(width, height, pixel)
+    tokens = compress(data)
+    if decompress(tokens, 0, len(data)) != data:
+        sys.exit('internal error: the compressed bitmap does not decompress correctly')
+    print('// %s: %d x %d pixels, compressed from %d to %d bytes' % (path, width, height, len(data), len(tokens) + 2))
+    print('const uint8_t %s [] PROGMEM = {' % name)
+    print('  %d, %d, // width in pixels, height in pages' % (width, pages))
+    lines = [tokens[i:i + 16] for i in range(0, len(tokens), 16)]
+    print(',\n'.join('  ' + ','.join('0x%02X' % v for v in line) for line in lines))
+    print('};')
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        sys.exit('Usage: bitmapcompress.py image name')
+    main(sys.argv[1], sys.argv[2])
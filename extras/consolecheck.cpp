@@ -0,0 +1,119 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks console mode, which scrolls the display by moving its start line, and draws relative to the scroll.
+ * Each case prints lines until the display has scrolled, and then draws with one of the renderers.
+ * What the display shows, as selected by its start line, must match the same text drawn at the same
+ * positions on a display that has not scrolled.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/consolecheck.cpp src/Tiny4kOLED.cpp -o consolecheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+#define PAGES 4
+
+static uint8_t expected[PAGES][128];
+static uint8_t shown[PAGES][128];
+
+// Reads back the pages the display shows, as the emulator's dump does.
+static void capture(uint8_t image[PAGES][128]) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	memset(image, 0, PAGES * 128);
+	for (uint8_t row = 0; row < PAGES * 8; row++) {
+		uint8_t y = (row + e.startLine + e.displayOffset) & 0x3F;
+		for (uint8_t x = 0; x < 128; x++) {
+			if (tiny4koled_emulator_pixel(x, y)) image[row >> 3][x] |= 1 << (row & 0x07);
+		}
+	}
+}
+
+// Prints five lines on a four page display, so that it scrolls by one page, or draws the four that stay in view.
+static void drawLines(bool console) {
+	beginDisplay(128, 32, sizeof(tiny4koled_init_128x32), tiny4koled_init_128x32);
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.clear();
+	oled.setFont(FONT6X8);
+	if (console) {
+		oled.setConsoleMode(true);
+		writeText("line A\nline B\nline C\nline D\nline E");
+	} else {
+		oled.setConsoleMode(false);
+		oled.setCursor(0, 0);
+		writeText("line B");
+		oled.setCursor(0, 1);
+		writeText("line C");
+		oled.setCursor(0, 2);
+		writeText("line D");
+		oled.setCursor(0, 3);
+		writeText("line E");
+	}
+}
+
+static void drawNothing(void) {
+}
+
+static void drawText(void) {
+	oled.setCursor(60, 1);
+	writeText("6x8");
+}
+
+static void drawString(void) {
+	oled.setCursor(60, 2);
+	oled.drawString(F("drawString"));
+}
+
+static void drawFill(void) {
+	oled.setCursor(100, 0);
+	oled.fillToEOL(0x18);
+}
+
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+static void drawX2(void) {
+	oled.setFontX2(FONT6X8);
+	oled.setCursor(60, 0);
+	writeText("x2");
+}
+
+static void drawX2Smooth(void) {
+	oled.setFontX2Smooth(FONT6X8);
+	oled.setCursor(60, 2);
+	writeText("x2");
+}
+#endif
+
+static uint16_t check(const char *name, void (*draw)(void)) {
+	drawLines(false);
+	draw();
+	capture(expected);
+	drawLines(true);
+	draw();
+	capture(shown);
+	oled.setConsoleMode(false);
+	uint16_t failures = 0;
+	for (uint8_t page = 0; page < PAGES; page++) {
+		if (memcmp(expected[page], shown[page], 128) != 0) {
+			printf("%s: shown page %u differs\n", name, page);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 32, sizeof(tiny4koled_init_128x32), tiny4koled_init_128x32)) return skipped("as it needs a 128x32 display");
+	failures += check("scrolled lines", drawNothing);
+	failures += check("text", drawText);
+	failures += check("drawString", drawString);
+	failures += check("fillToEOL", drawFill);
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	failures += check("X2", drawX2);
+	failures += check("X2 smooth", drawX2Smooth);
+#endif
+	printf("%u pages differ\n", failures);
+	return failures ? 1 : 0;
+}
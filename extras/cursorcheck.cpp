@@ -0,0 +1,122 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks the deferred cursor, which only sends the addressing commands before the next data,
+ * and leaves them out when the controller's address pointer is already at the cursor.
+ * Each case draws a character, then moves the cursor, or changes what it is relative to,
+ * and draws it again. The second character must land where a freshly positioned one would.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/cursorcheck.cpp src/Tiny4kOLED.cpp -o cursorcheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+static uint8_t glyph[6];
+
+static void start(void) {
+	beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	oled.setFont(FONT6X8);
+	memset(tiny4koled_emulator.ram, 0, sizeof(tiny4koled_emulator.ram));
+}
+
+static uint16_t expect(const char *name, uint8_t page, uint8_t column) {
+	if (memcmp(&tiny4koled_emulator.ram[page][column], glyph, sizeof(glyph)) != 0) {
+		printf("%s: the character is not at page %u column %u\n", name, page, column);
+		return 1;
+	}
+	return 0;
+}
+
+static uint16_t expectBlank(const char *name, uint8_t page) {
+	for (uint8_t column = 0; column < 128; column++) {
+		if (tiny4koled_emulator.ram[page][column]) {
+			printf("%s: page %u was drawn on\n", name, page);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Draws a character that leaves the controller's address pointer at column 15 of page 1,
+// then changes what the cursor is relative to, and draws another at the same logical position.
+static void drawTwice(void (*draw)(void), void (*change)(void)) {
+	start();
+	oled.setCursor(9, 1);
+	draw();
+	change();
+	oled.setCursor(15, 1);
+	memset(tiny4koled_emulator.ram, 0, sizeof(tiny4koled_emulator.ram));
+	draw();
+}
+
+static void drawWrite(void) { oled.write('A'); }
+static void drawString(void) { oled.drawString("A"); }
+static void drawFill(void) { for (uint8_t i = 0; i < sizeof(glyph); i++) oled.fillLength(glyph[i], 1); }
+
+static void switchFrame(void) { oled.switchRenderFrame(); }
+#ifndef TINY4KOLED_WIDTH
+static void offsetColumns(void) { oled.setOffset(32, 0); }
+static void offsetPages(void) { oled.setOffset(0, 16); }
+#endif
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+
+	start();
+	oled.setCursor(15, 1);
+	oled.write('A');
+	memcpy(glyph, &tiny4koled_emulator.ram[1][15], sizeof(glyph));
+
+	start();
+	oled.setCursor(15, 1);
+	oled.setCursor(40, 3);
+	oled.write('A');
+	failures += expect("moved twice", 3, 40);
+	failures += expectBlank("moved twice", 1);
+
+	start();
+	oled.setCursor(15, 1);
+	oled.write('A');
+	oled.setCursor(21, 1);
+	oled.write('A');
+	failures += expect("continued", 1, 21);
+
+	start();
+	oled.setCursor(15, 1);
+	oled.switchRenderFrame();
+	oled.write('A');
+	oled.switchRenderFrame();
+	failures += expect("setCursor then switchRenderFrame", 5, 15);
+	failures += expectBlank("setCursor then switchRenderFrame", 1);
+
+	drawTwice(drawWrite, switchFrame);
+	oled.switchRenderFrame();
+	failures += expect("write after switchRenderFrame", 5, 15);
+	drawTwice(drawString, switchFrame);
+	oled.switchRenderFrame();
+	failures += expect("drawString after switchRenderFrame", 5, 15);
+	drawTwice(drawFill, switchFrame);
+	oled.switchRenderFrame();
+	failures += expect("fillLength after switchRenderFrame", 5, 15);
+
+#ifndef TINY4KOLED_WIDTH
+	drawTwice(drawWrite, offsetColumns);
+	failures += expect("write after setOffset", 1, 47);
+	drawTwice(drawString, offsetColumns);
+	failures += expect("drawString after setOffset", 1, 47);
+	drawTwice(drawFill, offsetColumns);
+	failures += expect("fillLength after setOffset", 1, 47);
+
+	drawTwice(drawString, offsetPages);
+	failures += expect("drawString after a vertical setOffset", 3, 15);
+	drawTwice(drawFill, offsetPages);
+	failures += expect("fillLength after a vertical setOffset", 3, 15);
+#endif
+
+	printf("%u cursor cases differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks several displays driven from one program, each with its own state and I2C address.
+ * It is always built with TINY4KOLED_MULTIPLE_DISPLAYS, see the Makefile.
+ * Two emulated displays, a 128x64 at 0x3C and a 128x32 at 0x3D, are told apart by the address of each transaction.
+ * Drawing steps that change the font, cursor, render frame and other state of each display are interleaved,
+ * and each display must end up as it does when its steps are run on their own.
+ * Frame buffers flushed by alternately servicing each display must reach their own display.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -DTINY4KOLED_MULTIPLE_DISPLAYS -Iextras/host -Isrc extras/displayscheck.cpp src/Tiny4kOLED.cpp -o displayscheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+#ifndef TINY4KOLED_WIDTH
+typedef decltype(oled) Device;
+
+static SSD1306Emulator parked; // the display that is not in tiny4koled_emulator
+static uint8_t activeAddress = SSD1306;
+
+// Swaps in the emulated display at the address the library is sending to.
+static void selectDisplay(void) {
+	if (tiny4koled_address == activeAddress) return;
+	SSD1306Emulator swap = tiny4koled_emulator;
+	tiny4koled_emulator = parked;
+	parked = swap;
+	activeAddress = tiny4koled_address;
+}
+
+static void beginDisplays(void) {
+	selectDisplay();
+	tiny4koled_begin_emulator();
+}
+
+static bool beginTransmissionDisplays(void) {
+	selectDisplay();
+	return tiny4koled_beginTransmission_emulator();
+}
+
+static Device large(&beginDisplays, &beginTransmissionDisplays, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, TINY4KOLED_EMULATOR_BUFFER_LENGTH);
+static Device small(&beginDisplays, &beginTransmissionDisplays, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, TINY4KOLED_EMULATOR_BUFFER_LENGTH);
+
+static uint8_t expectedLarge[8][128], expectedSmall[8][128];
+static uint8_t frameLarge[8 * 128], frameSmall[8 * 128];
+
+static void start(void) {
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	memset(parked.ram, 0x5A, sizeof(parked.ram));
+	small.setAddress(0x3D);
+	large.begin(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	small.begin(128, 32, sizeof(tiny4koled_init_128x32), tiny4koled_init_128x32);
+}
+
+static void writeTo(Device &display, const char *text) {
+	while (*text) display.write(*text++);
+}
+
+static void stepLarge(uint8_t step) {
+	switch (step) {
+		case 0: large.setFont(FONT8X16); large.setCursor(5, 1); break;
+		case 1: writeTo(large, "Large"); break;
+		case 2: large.fillLength(0xF0, 12); break;
+		case 3: large.setCursor(0, 6); large.drawString("at 0x3C"); break;
+		case 4: writeTo(large, " +"); break;
+	}
+}
+
+static void stepSmall(uint8_t step) {
+	switch (step) {
+		case 0: small.setFont(FONT6X8); small.setCursor(40, 0); break;
+		case 1: writeTo(small, "small"); break;
+		case 2: small.switchRenderFrame(); small.setCursor(2, 3); break;
+		case 3: writeTo(small, "back frame"); small.fillToEOL(0x81); break;
+		case 4: small.switchRenderFrame(); writeTo(small, "!"); break;
+	}
+}
+
+// Copies the GDDRAM of the display at the address.
+static void capture(uint8_t address, uint8_t ram[8][128]) {
+	memcpy(ram, address == activeAddress ? tiny4koled_emulator.ram : parked.ram, sizeof(tiny4koled_emulator.ram));
+}
+
+static uint16_t compare(const char *name, uint8_t address, const uint8_t *expected) {
+	const uint8_t *ram = address == activeAddress ? &tiny4koled_emulator.ram[0][0] : &parked.ram[0][0];
+	if (memcmp(expected, ram, sizeof(tiny4koled_emulator.ram)) != 0) {
+		printf("%s: the display at 0x%02X differs\n", name, address);
+		return 1;
+	}
+	return 0;
+}
+
+static uint16_t checkInterleaved(void) {
+	uint16_t failures = 0;
+	start();
+	for (uint8_t step = 0; step < 5; step++) stepLarge(step);
+	capture(0x3C, expectedLarge);
+	for (uint8_t step = 0; step < 5; step++) stepSmall(step);
+	capture(0x3D, expectedSmall);
+
+	start();
+	for (uint8_t step = 0; step < 5; step++) {
+		stepSmall(step);
+		stepLarge(step);
+	}
+	failures += compare("interleaved", 0x3C, &expectedLarge[0][0]);
+	failures += compare("interleaved", 0x3D, &expectedSmall[0][0]);
+	return failures;
+}
+
+static uint16_t checkFrameBuffers(void) {
+	uint16_t failures = 0;
+	DCFrameBuffer fbLarge = {}, fbSmall = {};
+	start();
+	memset(tiny4koled_emulator.ram, 0, sizeof(tiny4koled_emulator.ram));
+	memset(parked.ram, 0, sizeof(parked.ram));
+	fbLarge.buffer = frameLarge;
+	fbLarge.pages = 8;
+	fbSmall.buffer = frameSmall;
+	fbSmall.pages = 8;
+	large.setFrameBuffer(&fbLarge);
+	small.setFrameBuffer(&fbSmall);
+	large.clear();
+	small.clear();
+	for (uint8_t step = 0; step < 5; step++) {
+		stepLarge(step);
+		stepSmall(step);
+	}
+	bool largeBusy = true, smallBusy = true;
+	while (largeBusy || smallBusy) {
+		if (largeBusy) largeBusy = large.service(30);
+		if (smallBusy) smallBusy = small.service(30);
+	}
+	large.setFrameBuffer(0);
+	small.setFrameBuffer(0);
+	capture(0x3C, expectedLarge);
+	capture(0x3D, expectedSmall);
+	if (memcmp(frameLarge, expectedLarge, sizeof(frameLarge)) != 0) {
+		printf("frame buffers: the display at 0x3C differs from its frame buffer\n");
+		failures++;
+	}
+	if (memcmp(frameSmall, expectedSmall, sizeof(frameSmall)) != 0) {
+		printf("frame buffers: the display at 0x3D differs from its frame buffer\n");
+		failures++;
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	failures += checkInterleaved();
+	failures += checkFrameBuffers();
+	printf("%u displays differ\n", failures);
+	return failures ? 1 : 0;
+}
+#else
+int main(void) {
+	return skipped("as the displays are of different sizes");
+}
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks that fill, which sends the whole screen as one run through a horizontal addressing window,
+ * changes the same GDDRAM as filling each page in turn, for each screen size and both render frames.
+ * With the second render frame, the pages of screens taller than 32 pixels wrap past page 7.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/fillcheck.cpp src/Tiny4kOLED.cpp -o fillcheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+static uint16_t checkFill(const char *name, uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) {
+	uint16_t failures = 0;
+	uint8_t expected[8][128];
+	if (!beginDisplay(width, height, init_sequence_length, init_sequence)) return 0;
+	for (uint8_t frame = 0; frame < 2; frame++) {
+		if (frame) oled.switchRenderFrame();
+
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		for (uint8_t page = 0; page < height / 8; page++) {
+			oled.setCursor(0, page);
+			oled.fillToEOP(0xC3);
+		}
+		memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		oled.fill(0xC3);
+		if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+			printf("%s: fill differs in render frame %u\n", name, frame);
+			failures++;
+		}
+	}
+	oled.switchRenderFrame();
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	failures += checkFill("128x64", 128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	failures += checkFill("128x32", 128, 32, sizeof(tiny4koled_init_128x32), tiny4koled_init_128x32);
+	failures += checkFill("72x40", 72, 40, sizeof(tiny4koled_init_72x40), tiny4koled_init_72x40);
+	failures += checkFill("64x48", 64, 48, sizeof(tiny4koled_init_64x48), tiny4koled_init_64x48);
+	failures += checkFill("64x32", 64, 32, sizeof(tiny4koled_init_64x32), tiny4koled_init_64x32);
+	printf("%u fills differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks text drawn with the decoder and renderer fixed at compile time, which are then called directly.
+ * It is always built with TINY4KOLED_NO_UNICODE and TINY4KOLED_ONLY_ORIGINAL_SIZE, see the Makefile.
+ * Text with carriage returns, new lines, characters the font does not include, and lines long enough
+ * to wrap is written in several fonts, and must match a reference that lays out the font's glyphs
+ * as the dispatched ASCII decoder and original size renderer do.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -DTINY4KOLED_NO_UNICODE -DTINY4KOLED_ONLY_ORIGINAL_SIZE -Iextras/host -Isrc extras/fixedcheck.cpp src/Tiny4kOLED.cpp -o fixedcheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+static const char text[] = "Fixed\r\nrender {x}\x01 wraps at the end\nok";
+
+static uint8_t expected[8][128];
+
+// Lays out the text from the top left, starting a new line when a character doesn't fit, and at each new line.
+static void referenceText(const DCfont *font, const char *p) {
+	uint8_t spacing = font->width ? 0 : font->spacing;
+	uint8_t h = font->height;
+	uint8_t x = 0, y = 0;
+	for (; *p; p++) {
+		uint8_t c = *p;
+		if (c == '\n') {
+			x = 0;
+			y += h;
+			continue;
+		}
+		if (c < font->first || c > font->last) continue;
+		uint8_t w = oled.getCharacterWidth(c);
+		if (x > 128 - w) {
+			x = 0;
+			y += h;
+		}
+		const uint8_t *cPtr = &font->bitmap[oled.getCharacterDataOffset(c)];
+		uint8_t columns = (x + w + spacing > 128) ? w : w + spacing;
+		for (uint8_t page = 0; page < h; page++) {
+			for (uint8_t col = 0; col < columns; col++) {
+				expected[y + page][x + col] = col < w ? pgm_read_byte(cPtr + page * w + col) : 0;
+			}
+		}
+		x += columns;
+	}
+}
+
+static uint16_t checkFont(const char *name, const DCfont *font) {
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+	oled.setFont(font);
+	referenceText(font, text);
+	oled.setCursor(0, 0);
+	writeText(text);
+	if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+		printf("%s: the text differs\n", name);
+		return 1;
+	}
+#ifndef TINY4KOLED_NO_PRINT
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+	referenceText(font, "-42 350");
+	oled.setCursor(0, 0);
+	oled.print(-42);
+	oled.print(' ');
+	oled.print(350u);
+	if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+		printf("%s: the printed numbers differ\n", name);
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	failures += checkFont("FONT6X8", FONT6X8);
+	failures += checkFont("FONT6X8P", FONT6X8P);
+	failures += checkFont("FONT8X16", FONT8X16);
+	failures += checkFont("FONT8X16P", FONT8X16P);
+	failures += checkFont("FONT8X16CAPS", FONT8X16CAPS);
+	printf("%u fonts differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#
+# Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+#
+# Generates a compressed copy of each font in a font header.
+#
+# Usage: fontcompress.py font.h
+#
+# The glyphs are reordered column by column, each column's pages from the top,
+# and each byte is replaced by its canonical Huffman code. The printed arrays,
+# DCFontCompression tables and DCfont replace the original bitmap data. The
+# DCfont is named after the original, with Compressed appended.
+#
+
+import heapq
+import re
+import sys
+
+MAX_CODE_LENGTH = 16
+
+def arrays(source):
+    found = {}
+    for array in re.finditer(r'const\s+uint(?:8|16)_t\s+(\w+)\s*\[\]\s*PROGMEM\s*=\s*\{(.*?)\};', source, re.S):
+        body = re.sub(r'//[^\n]*', '', array.group(2))
+        found[array.group(1)] = [int(v, 0) for v in re.findall(r'0x[0-9A-Fa-f]+|\d+', body)]
+    return found
+
+def code_lengths(frequencies):
+    if len(frequencies) == 1:
+        return {symbol: 1 for symbol in frequencies}
+    heap = [(count, i, [symbol]) for i, (symbol, count) in enumerate(sorted(frequencies.items()))]
+    heapq.heapify(heap)
+    lengths = {symbol: 0 for symbol in frequencies}
+    order = len(heap)
+    while len(heap) > 1:
+        count1, _, symbols1 = heapq.heappop(heap)
+        count2, _, symbols2 = heapq.heappop(heap)
+        for symbol in symbols1 + symbols2:
+            lengths[symbol] += 1
+        heapq.heappush(heap, (count1 + count2, order, symbols1 + symbols2))
+        order += 1
+    if max(lengths.values()) > MAX_CODE_LENGTH:
+        sys.exit('the glyph data needs codes longer than %d bits' % MAX_CODE_LENGTH)
+    return lengths
+
+def canonical_codes(lengths):
+    symbols = sorted(lengths, key=lambda symbol: (lengths[symbol], symbol))
+    codes = {}
+    code = 0
+    length = lengths[symbols[0]]
+    for symbol in symbols:
+        code <<= lengths[symbol] - length
+        length = lengths[symbol]
+        codes[symbol] = (code, length)
+        code += 1
+    return symbols, codes
+
+def print_array(kind, name, values, per_line=16):
+    print('const %s %s [] PROGMEM = {' % (kind, name))
+    lines = [values[i:i + per_line] for i in range(0, len(values), per_line)]
+    print(',\n'.join('  ' + ','.join('0x%02X' % v if kind == 'uint8_t' else str(v) for v in line) for line in lines))
+    print('};')
+    print()
+
+def compress(name, members, found):
+    bitmap_name = re.search(r'(\w+)\s*$', members[0]).group(1)
+    width = int(members[1], 0)
+    height = int(members[2], 0)
+    first = int(members[3], 0)
+    last = int(members[4], 0)
+    bitmap = found[bitmap_name]
+    count = last - first + 1
+    if width:
+        widths = [width] * count
+        widths_name = None
+    else:
+        widths_name = re.search(r'(\w+_widths)\b', ','.join(members)).group(1)
+        widths = found[widths_name][:count]
+    spacing = members[7] if len(members) > 7 else '0'
+
+    glyphs = []
+    offset = 0
+    for w in widths:
+        glyphs.append([bitmap[offset + page * w + col] for col in range(w) for page in range(height)])
+        offset += w * height
+
+    frequencies = {}
+    for glyph in glyphs:
+        for byte in glyph:
+            frequencies[byte] = frequencies.get(byte, 0) + 1
+    lengths = code_lengths(frequencies)
+    symbols, codes = canonical_codes(lengths)
+    max_length = max(lengths.values())
+    length_counts = [sum(1 for s in symbols if lengths[s] == l) for l in range(1, max_length + 1)]
+
+    bits = []
+    checkpoints = []
+    for index, glyph in enumerate(glyphs):
+        if index % 16 == 0:
+            checkpoints.append(len(bits))
+        for byte in glyph:
+            code, length = codes[byte]
+            bits.extend((code >> (length - 1 - i)) & 1 for i in range(length))
+    if len(bits) > 0xFFFF:
+        sys.exit('%s: the compressed data is too large for 16 bit offsets' % name)
+    data = []
+    for i in range(0, len(bits), 8):
+        chunk = bits[i:i + 8] + [0] * (8 - len(bits[i:i + 8]))
+        data.append(sum(bit << (7 - j) for j, bit in enumerate(chunk)))
+
+    base = bitmap_name + '_compressed'
+    print('// %s compressed from %d to %d bytes' % (name, len(bitmap), len(data) + len(symbols) + len(length_counts) + 2 * len(checkpoints)))
+    print_array('uint8_t', base, data)
+    print_array('uint8_t', base + '_symbols', symbols)
+    print_array('uint8_t', base + '_lengths', length_counts)
+    print_array('uint16_t', base + '_checkpoints', checkpoints)
+    if widths_name:
+        print_array('uint8_t', base + '_widths', widths)
+    print('const DCFontCompression %s_compression = {' % name)
+    print('  (uint8_t *)%s_symbols,' % base)
+    print('  (uint8_t *)%s_lengths,' % base)
+    print('  %d, // longest code in bits' % max_length)
+    print('  (uint16_t *)%s_checkpoints' % base)
+    print('  };')
+    print()
+    print('const DCfont %sCompressed = {' % name)
+    print('  (uint8_t *)%s,' % base)
+    print('  %d, // character width in pixels' % width)
+    print('  %d, // character height in pages (8 pixels)' % height)
+    print('  %d,%d, // ASCII extents' % (first, last))
+    print('  0,')
+    print('  %s,' % ('(uint8_t *)%s_widths' % base if widths_name else '0'))
+    print('  %s, // spacing' % spacing)
+    print('  0, // offsets are not used')
+    print('  &%s_compression' % name)
+    print('  };')
+    print()
+
+def main(path):
+    source = open(path).read()
+    found = arrays(source)
+    for font in re.finditer(r'const\s+DCfont\s+(\w+)\s*=\s*\{(.*?)\};', source, re.S):
+        body = re.sub(r'//[^\n]*', '', font.group(2))
+        body = re.sub(r'#\w+[^\n]*', '', body)
+        members = [m.strip() for m in body.split(',') if m.strip()]
+        compress(font.group(1), members, found)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.exit('Usage: fontcompress.py font.h')
+    main(sys.argv[1])
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#
+# Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+#
+# Generates the optional offsets table of a proportional font, so that
+# finding a character's bitmap does not require summing the widths of
+# all the characters before it.
+#
+# Usage: fontoffsets.py font.h
+#
+# For each widths table in the font header, a matching offsets table is
+# printed, to be pasted into the header and referenced as the last member
+# of the DCfont.
+#
+
+import re
+import sys
+
+def main(path):
+    source = open(path).read()
+    fonts = re.finditer(r'const\s+DCfont\s+\w+\s*=\s*\{(.*?)\};', source, re.S)
+    for font in fonts:
+        members = [m.split('//')[0].strip() for m in font.group(1).split('\n')]
+        members = [m for m in ','.join(members).split(',') if m.strip()]
+        height = int(members[2], 0)
+        widths_name = re.search(r'\(uint8_t \*\)\s*(\w+_widths)\b', font.group(1)).group(1)
+        widths = re.search(r'const\s+uint8_t\s+' + widths_name + r'\s*\[\]\s*PROGMEM\s*=\s*\{(.*?)\};', source, re.S)
+        widths = [int(w, 0) for w in re.findall(r'0x[0-9A-Fa-f]+|\d+', widths.group(1))]
+
+        offsets = []
+        offset = 0
+        for width in widths:
+            offsets.append(offset)
+            offset += width * height
+        if offset > 0xFFFF:
+            sys.exit('%s: the bitmap data is too large for 16 bit offsets' % widths_name)
+
+        name = widths_name[:-len('_widths')] + '_offsets'
+        print('const uint16_t %s [] PROGMEM = {' % name)
+        lines = [offsets[i:i + 16] for i in range(0, len(offsets), 16)]
+        print(',\n'.join('  ' + ','.join(str(o) for o in line) for line in lines))
+        print('};')
+        print()
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.exit('Usage: fontoffsets.py font.h')
+    main(sys.argv[1])
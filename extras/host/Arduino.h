@@ -0,0 +1,65 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * The parts of the Arduino core that the library uses, for desktop builds with the emulator.
+ * Flash strings are ordinary strings, and the pin functions do nothing.
+ */
+#ifndef TINY4KOLED_HOST_ARDUINO_H
+#define TINY4KOLED_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "avr/pgmspace.h"
+
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+#define MSBFIRST 1
+
+static inline void pinMode(uint8_t, uint8_t) {}
+static inline void digitalWrite(uint8_t, uint8_t) {}
+static inline void delay(unsigned long) {}
+static inline void delayMicroseconds(unsigned int) {}
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class Print {
+	public:
+		virtual ~Print() {}
+		virtual size_t write(uint8_t) = 0;
+		virtual size_t write(const uint8_t *buffer, size_t size) {
+			size_t n = 0;
+			while (size--) n += write(*buffer++);
+			return n;
+		}
+		size_t write(const char *str) {
+			if (str == NULL) return 0;
+			return write((const uint8_t *)str, strlen(str));
+		}
+		size_t print(const __FlashStringHelper *ifsh) { return write(reinterpret_cast<const char *>(ifsh)); }
+		size_t print(const char *str) { return write(str); }
+		size_t print(char c) { return write((uint8_t)c); }
+		size_t print(long n) {
+			char buf[12];
+			snprintf(buf, sizeof(buf), "%ld", n);
+			return write(buf);
+		}
+		size_t print(int n) { return print((long)n); }
+		size_t print(unsigned int n) { return print((long)n); }
+		size_t println(void) { return write('\r') + write('\n'); }
+		size_t println(const __FlashStringHelper *ifsh) { return print(ifsh) + println(); }
+		size_t println(const char *str) { return print(str) + println(); }
+		size_t println(long n) { return print(n) + println(); }
+		size_t println(int n) { return print(n) + println(); }
+};
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Helpers shared by the desktop checks in extras, so that they build with any of the configuration defines.
+ * Include it after the header that defines the oled.
+ */
+#ifndef TINY4KOLED_HOST_CHECK_H
+#define TINY4KOLED_HOST_CHECK_H
+
+// Begins the display at the given size. When the geometry is fixed for the whole build,
+// only that size can be begun, and false is returned for any other.
+static bool beginDisplay(uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) __attribute__((unused));
+static bool beginDisplay(uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) {
+#ifdef TINY4KOLED_WIDTH
+	if (width != TINY4KOLED_WIDTH || height != TINY4KOLED_HEIGHT) return false;
+	oled.begin(init_sequence_length, init_sequence);
+#else
+	oled.begin(width, height, init_sequence_length, init_sequence);
+#endif
+	return true;
+}
+
+// Prints text through write, which the device has even when TINY4KOLED_NO_PRINT leaves out Print.
+static void writeText(const char *text) __attribute__((unused));
+static void writeText(const char *text) {
+	while (*text) oled.write(*text++);
+}
+
+// Ends a check that can't run in this configuration, without failing.
+static int skipped(const char *reason) __attribute__((unused));
+static int skipped(const char *reason) {
+	printf("skipped, %s\n", reason);
+	return 0;
+}
+
+#endif
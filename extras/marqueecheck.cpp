@@ -0,0 +1,113 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks the marquee, which scrolls a line of text a column at a time, sending only the revealed column.
+ * The emulator shifts the region's content as soon as scrollMarquee's command arrives.
+ * After every step, for more steps than the text has columns, the region must show the same columns
+ * as clipTextP drawing the text three times over, from the number of steps taken, modulo the text's width.
+ * The text is also scrolled as UTF-8, with a character no font covers, which must be skipped.
+ * Each step must send a single column of the region's height, and leave the cursor where it was.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/marqueecheck.cpp src/Tiny4kOLED.cpp -o marqueecheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+#define TEXT "News {12} ... "
+
+static const char text[] PROGMEM = TEXT;
+static const char repeated[] PROGMEM = TEXT TEXT TEXT;
+static const char textRAM[] = TEXT;
+// The same text with a character that no font covers, which the marquee skips.
+static const char textUTF8[] = "News {12}\xC3\xA9 ... ";
+
+static uint8_t shown[8][128];
+
+#ifndef TINY4KOLED_NO_UNICODE
+static const DCUnicodeFontRef asciiRef = { 0x00, 0x00, FONT6X8 };
+static const DCUnicodeFont unicode = { 6, 1, &asciiRef, 0 };
+#endif
+
+// The width of the text in columns, including the spacing after each character.
+static uint16_t textWidth(const DCfont *font) {
+	uint16_t width = 0;
+	for (const char *p = textRAM; *p; p++) width += oled.getCharacterWidth(*p) + font->spacing;
+	return width;
+}
+
+static uint16_t compareRegion(const char *name, uint16_t step, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+	for (uint8_t page = y; page < y + height; page++) {
+		if (memcmp(&shown[page][x], &tiny4koled_emulator.ram[page][x], width) != 0) {
+			printf("%s: step %u differs on page %u\n", name, step, page);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Scrolls the text from PROGMEM, or from RAM, through the current font.
+static uint16_t checkMarquee(const char *name, const DCfont *font, bool progmem, const char *ram, uint8_t x, uint8_t y, uint8_t width) {
+	uint16_t failures = 0;
+	DCMarquee marquee;
+	uint16_t length = textWidth(font);
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.setCursor(x, y);
+	if (progmem) {
+		oled.startMarquee(&marquee, (DATACUTE_F_MACRO_T *)text, width);
+	} else {
+		oled.startMarquee(&marquee, ram, width);
+	}
+	oled.setCursor(3, 7);
+	for (uint16_t step = 0; step <= length + 5; step++) {
+		if (step) {
+			tiny4koled_emulator_reset_counters();
+			oled.scrollMarquee(&marquee);
+			uint32_t scrollBytes = tiny4koled_emulator.dataBytes;
+			oled.drawMarquee(&marquee);
+			if (oled.getCursorX() != 3 || oled.getCursorY() != 7) {
+				printf("%s: step %u moved the cursor\n", name, step);
+				failures++;
+			}
+			if (tiny4koled_emulator.dataBytes - scrollBytes != font->height) {
+				printf("%s: step %u sent %u data bytes\n", name, step, tiny4koled_emulator.dataBytes - scrollBytes);
+				failures++;
+			}
+		}
+		memcpy(shown, tiny4koled_emulator.ram, sizeof(shown));
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		oled.setFont(font);
+		oled.setCursor(x, y);
+		oled.clipTextP(step % length, width, (DATACUTE_F_MACRO_T *)repeated);
+		failures += compareRegion(name, step, x, y, width, font->height);
+		memcpy(tiny4koled_emulator.ram, shown, sizeof(shown));
+#ifndef TINY4KOLED_NO_UNICODE
+		if (ram == textUTF8) oled.setUnicodeFont(&unicode);
+#endif
+		oled.setCursor(3, 7);
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	oled.setFont(FONT6X8);
+	failures += checkMarquee("FONT6X8 from PROGMEM", FONT6X8, true, 0, 0, 0, 128);
+	oled.setFont(FONT6X8);
+	failures += checkMarquee("FONT6X8 from RAM", FONT6X8, false, textRAM, 10, 2, 50);
+	oled.setFont(FONT6X8P);
+	failures += checkMarquee("FONT6X8P", FONT6X8P, true, 0, 7, 1, 33);
+	oled.setFont(FONT8X16);
+	failures += checkMarquee("FONT8X16", FONT8X16, false, textRAM, 20, 4, 64);
+	oled.setFont(FONT8X16P);
+	failures += checkMarquee("FONT8X16P", FONT8X16P, true, 0, 0, 5, 101);
+#ifndef TINY4KOLED_NO_UNICODE
+	oled.setUnicodeFont(&unicode);
+	failures += checkMarquee("FONT6X8 as UTF-8", FONT6X8, false, textUTF8, 0, 6, 90);
+#endif
+	printf("%u marquee steps differ\n", failures);
+	return failures ? 1 : 0;
+}
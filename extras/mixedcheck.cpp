@@ -0,0 +1,108 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks mixed transactions, where the commands that move the cursor are each preceded by a continuation
+ * control byte, and share a transaction with the data that follows. It is always built with
+ * TINY4KOLED_MIXED_TRANSACTIONS, see the Makefile.
+ * Fills after cursor moves must change the expected GDDRAM in one transaction each, including when the
+ * transaction is split at small payloads, and a frame buffer's changes must reach the display unaltered.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -DTINY4KOLED_MIXED_TRANSACTIONS -Iextras/host -Isrc extras/mixedcheck.cpp src/Tiny4kOLED.cpp -o mixedcheck
+ * With -DTINY4KOLED_MULTIPLE_DISPLAYS, only the emulator's default payload is checked.
+ */
+#include <new>
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+typedef decltype(oled) Device;
+
+static uint8_t expected[8][128];
+static uint8_t frame[8 * 128];
+
+// Constructs the oled again, to change the payload the library is told of.
+static void usePayload(uint16_t payload) {
+#ifndef TINY4KOLED_MULTIPLE_DISPLAYS
+	new (&oled) Device(&tiny4koled_begin_emulator, &tiny4koled_beginTransmission_emulator, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, payload);
+#endif
+	beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	tiny4koled_emulator.bufferLength = payload;
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+}
+
+static uint16_t checkFills(uint16_t payload) {
+	static const uint8_t fills[][4] = {
+		// x, page, length, byte
+		{ 0, 0, 10, 0xFF },
+		{ 17, 3, 1, 0x81 },
+		{ 100, 7, 28, 0x3C },
+		{ 64, 4, 40, 0x00 },
+		{ 5, 3, 3, 0xA5 },
+	};
+	uint16_t failures = 0;
+	usePayload(payload);
+	for (uint8_t i = 0; i < sizeof(fills) / sizeof(fills[0]); i++) {
+		const uint8_t *f = fills[i];
+		memset(&expected[f[1]][f[0]], f[3], f[2]);
+		tiny4koled_emulator_reset_counters();
+		oled.setCursor(f[0], f[1]);
+		oled.fillLength(f[3], f[2]);
+		if (payload == 0 && tiny4koled_emulator.transactions != 1) {
+			printf("fill %u took %u transactions\n", i, tiny4koled_emulator.transactions);
+			failures++;
+		}
+		if (tiny4koled_emulator.addressingMode != 2) {
+			printf("fill %u left the display in addressing mode %u\n", i, tiny4koled_emulator.addressingMode);
+			failures++;
+		}
+	}
+	if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+		printf("fills differ with a payload of %u\n", payload);
+		failures++;
+	}
+	return failures;
+}
+
+static uint16_t checkFrameBuffer(const char *name, uint16_t payload, bool step) {
+	DCFrameBuffer fb = {};
+	usePayload(payload);
+	fb.buffer = frame;
+	fb.pages = 8;
+	oled.setFrameBuffer(&fb);
+	oled.clear();
+	oled.setFont(FONT8X16);
+	oled.setCursor(9, 1);
+	writeText("Mixed");
+	oled.setCursor(70, 6);
+	oled.fillLength(0x99, 30);
+	if (step) {
+		while (oled.service(40));
+	} else {
+		oled.flush();
+	}
+	oled.setFrameBuffer(0);
+	if (memcmp(frame, tiny4koled_emulator.ram, sizeof(frame)) != 0) {
+		printf("%s: differs with a payload of %u\n", name, payload);
+		return 1;
+	}
+	return 0;
+}
+
+int main(void) {
+	static const uint16_t payloads[] = { 0, 4, 5, 6, 7, 8, 32 };
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	for (uint8_t i = 0; i < sizeof(payloads) / sizeof(payloads[0]); i++) {
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+		if (payloads[i] != TINY4KOLED_EMULATOR_BUFFER_LENGTH) continue;
+#endif
+		failures += checkFills(payloads[i]);
+		failures += checkFrameBuffer("flush", payloads[i], false);
+		failures += checkFrameBuffer("service", payloads[i], true);
+	}
+	printf("%u mixed transaction cases differ\n", failures);
+	return failures ? 1 : 0;
+}
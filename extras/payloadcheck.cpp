@@ -0,0 +1,123 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks that drawing gives the same GDDRAM whatever the transport's maximum payload,
+ * which the library splits transactions at. Each drawing is done once without a limit,
+ * and then with the emulator's buffer, and the payload the library is told of, cut down.
+ * A command and its arguments must not be split across transactions.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/payloadcheck.cpp src/Tiny4kOLED.cpp -o payloadcheck
+ * With -DTINY4KOLED_MULTIPLE_DISPLAYS, only the emulator's default payload is checked.
+ */
+#include <new>
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+typedef decltype(oled) Device;
+
+// Constructs the oled again, to change the payload the library is told of.
+static void usePayload(uint16_t payload) {
+#ifndef TINY4KOLED_MULTIPLE_DISPLAYS
+	new (&oled) Device(&tiny4koled_begin_emulator, &tiny4koled_beginTransmission_emulator, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, payload);
+#endif
+	beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	tiny4koled_emulator.bufferLength = payload;
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+}
+
+static uint8_t frame[8 * 128];
+static uint8_t tile[16];
+
+static void drawScene(void) {
+	oled.setFont(FONT8X16);
+	oled.setCursor(3, 0);
+	oled.drawString("Payload");
+	oled.setFont(FONT6X8);
+	oled.setCursor(0, 3);
+	oled.drawString("split at the transport");
+	oled.setCursor(20, 5);
+	oled.fillLength(0x81, 70);
+	oled.setCursor(100, 6);
+	oled.write('x');
+	oled.write('y');
+}
+
+static void drawDirect(void) {
+	oled.clear();
+	drawScene();
+}
+
+static void attachFrameBuffer(DCFrameBuffer *fb) {
+	memset(fb, 0, sizeof(*fb));
+	fb->buffer = frame;
+	fb->pages = 8;
+	oled.setFrameBuffer(fb);
+	oled.clear();
+	drawScene();
+}
+
+static void drawFlush(void) {
+	DCFrameBuffer fb;
+	attachFrameBuffer(&fb);
+	oled.flush();
+	oled.setFrameBuffer(0);
+}
+
+static void drawFlushStep(void) {
+	DCFrameBuffer fb;
+	attachFrameBuffer(&fb);
+	while (oled.flushStep());
+	oled.setFrameBuffer(0);
+}
+
+static void drawService(void) {
+	DCFrameBuffer fb;
+	attachFrameBuffer(&fb);
+	while (oled.service(40));
+	oled.setFrameBuffer(0);
+}
+
+static void drawTile(uint8_t, uint8_t, uint8_t *) {
+	drawScene();
+}
+
+static void drawTiles(void) {
+	oled.drawTiles(tile, sizeof(tile), drawTile);
+}
+
+static uint8_t reference[8][128];
+
+static uint16_t check(const char *name, void (*draw)(void)) {
+	static const uint16_t payloads[] = { 4, 5, 8, 10, 16, 32 };
+	uint16_t failures = 0;
+	usePayload(0);
+	draw();
+	memcpy(reference, tiny4koled_emulator.ram, sizeof(reference));
+	for (uint8_t i = 0; i < sizeof(payloads) / sizeof(payloads[0]); i++) {
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+		if (payloads[i] != TINY4KOLED_EMULATOR_BUFFER_LENGTH) continue;
+#endif
+		usePayload(payloads[i]);
+		draw();
+		if (memcmp(reference, tiny4koled_emulator.ram, sizeof(reference)) != 0) {
+			printf("%s: differs with a payload of %u\n", name, payloads[i]);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	failures += check("direct", drawDirect);
+	failures += check("flush", drawFlush);
+	failures += check("flushStep", drawFlushStep);
+	failures += check("service", drawService);
+	failures += check("drawTiles", drawTiles);
+	printf("%u payloads differ\n", failures);
+	return failures ? 1 : 0;
+}
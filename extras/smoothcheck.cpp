@@ -0,0 +1,92 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks the smooth double size renderer against a reference implementation,
+ * which tests each pair of rows of each pair of columns one bit at a time.
+ * Every character of the supplied fonts is drawn with setFontX2Smooth into the
+ * emulator, and compared bit for bit with the reference rendering.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/smoothcheck.cpp src/Tiny4kOLED.cpp -o smoothcheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+static uint32_t referenceStretch(uint16_t x) {
+	uint32_t result = 0;
+	for (uint8_t i = 0; i < 16; i++) {
+		if (x & (1 << i)) result |= (uint32_t)3 << (i * 2);
+	}
+	return result;
+}
+
+// Renders one character into columns of up to 4 pages, two columns for each column of the font.
+static void referenceSmooth(const DCfont *font, uint8_t c, uint32_t *columns) {
+	uint8_t w = oled.getCharacterWidth(c);
+	const uint8_t *cPtr = &font->bitmap[oled.getCharacterDataOffset(c)];
+	uint16_t bits[256];
+	for (uint8_t col = 0; col < w; col++) {
+		bits[col] = pgm_read_byte(cPtr + col);
+		if (font->height > 1) bits[col] |= (uint16_t)pgm_read_byte(cPtr + col + w) << 8;
+		columns[col * 2] = columns[col * 2 + 1] = referenceStretch(bits[col]);
+	}
+	for (uint8_t col = 1; col < w; col++) {
+		uint16_t col0 = bits[col - 1], col1 = bits[col];
+		for (uint8_t i = 0; i < 16; i++) {
+			for (uint8_t j = 1; j < 3; j++) {
+				if (((col0 >> i & 0b11) == (uint8_t)(3 - j)) && ((col1 >> i & 0b11) == j)) {
+					columns[col * 2 - 1] |= (uint32_t)1 << ((i * 2) + j);
+					columns[col * 2] |= (uint32_t)1 << ((i * 2) + 3 - j);
+				}
+			}
+		}
+	}
+}
+
+static uint16_t checkFont(const char *name, const DCfont *font) {
+	uint16_t failures = 0;
+	oled.setFontX2Smooth(font);
+	for (uint16_t c = font->first; c <= font->last; c++) {
+		uint32_t expected[256];
+		uint8_t w = oled.getCharacterWidth(c);
+		referenceSmooth(font, c, expected);
+		memset(tiny4koled_emulator.ram, 0, sizeof(tiny4koled_emulator.ram));
+		oled.setCursor(0, 0);
+		oled.write(c);
+		bool same = true;
+		for (uint8_t col = 0; same && col < w * 2; col++) {
+			for (uint8_t page = 0; same && page < font->height * 2; page++) {
+				if (tiny4koled_emulator.ram[page][col] != (uint8_t)(expected[col] >> (page * 8))) {
+					printf("%s: character 0x%02X differs at column %u, page %u\n", name, c, col, page);
+					failures++;
+					same = false;
+				}
+			}
+		}
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	failures += checkFont("FONT6X8", FONT6X8);
+	failures += checkFont("FONT6X8P", FONT6X8P);
+	failures += checkFont("FONT6X8CAPS", FONT6X8CAPS);
+	failures += checkFont("FONT6X8DIGITS", FONT6X8DIGITS);
+	failures += checkFont("FONT8X16", FONT8X16);
+	failures += checkFont("FONT8X16P", FONT8X16P);
+	failures += checkFont("FONT8X16CAPS", FONT8X16CAPS);
+	failures += checkFont("FONT8X16CAPSP", FONT8X16CAPSP);
+	failures += checkFont("FONT8X16DIGITS", FONT8X16DIGITS);
+	printf("%u characters differ\n", failures);
+	return failures ? 1 : 0;
+}
+#else
+int main(void) {
+	return skipped("as TINY4KOLED_ONLY_ORIGINAL_SIZE leaves out setFontX2Smooth");
+}
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks the SPI transport, by feeding the emulator through the D/C# pin instead of control bytes.
+ * Each drawing is done once through the SPI transport, and once into a frame buffer,
+ * which decodes the control bytes the library writes. The emulator's GDDRAM must match the frame buffer.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/spicheck.cpp src/Tiny4kOLED.cpp -o spicheck
+ * Building with -DTINY4KOLED_MIXED_TRANSACTIONS checks the continuation control bytes.
+ */
+#define TINY4KOLED_EMULATOR_NO_DEVICE
+#define TINY4KOLED_SPI_BUS
+#include "Tiny4kOLED_emulator.h"
+#include "Tiny4kOLED_SPI.h"
+#include "check.h"
+
+static bool dcLevel;
+
+static void tiny4koled_spi_bus_begin(void) {
+	tiny4koled_begin_emulator();
+}
+
+static void tiny4koled_spi_bus_select(bool selected) {
+	if (selected) tiny4koled_emulator_spi_select();
+}
+
+static void tiny4koled_spi_bus_dc(bool data) {
+	dcLevel = data;
+}
+
+static void tiny4koled_spi_bus_transfer(uint8_t byte) {
+	tiny4koled_emulator_spi_transfer(byte, dcLevel);
+}
+
+static const uint8_t pattern[] PROGMEM = {
+	0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0x00
+};
+
+static void drawText(void) {
+	oled.clear();
+	oled.setFont(FONT8X16);
+	oled.setCursor(0, 0);
+	writeText("SPI 10MHz");
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	oled.setFontX2Smooth(FONT6X8);
+	oled.setCursor(4, 2);
+	writeText("D/C");
+#endif
+	oled.setFont(FONT6X8);
+	oled.setCursor(0, 5);
+	oled.drawString(F("drawString"));
+	oled.bitmap(100, 4, 116, 5, pattern);
+	oled.setCursor(64, 7);
+	oled.fillToEOL(0x18);
+}
+
+static void drawFill(void) {
+	oled.fill(0xA5);
+	oled.setCursor(10, 3);
+	oled.clearToEOL();
+}
+
+static uint8_t frame[8 * 128];
+
+static uint16_t check(const char *name, void (*draw)(void)) {
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	tiny4koled_emulator_reset_counters();
+	draw();
+	printf("%s: %u bytes over SPI, %u transactions\n", name, tiny4koled_emulator.bytes, tiny4koled_emulator.transactions);
+	DCFrameBuffer fb = {};
+	fb.buffer = frame;
+	fb.pages = 8;
+	oled.setFrameBuffer(&fb);
+	draw();
+	oled.setFrameBuffer(0);
+	uint16_t failures = 0;
+	for (uint8_t page = 0; page < 8; page++) {
+		if (memcmp(tiny4koled_emulator.ram[page], &frame[page * 128], 128) != 0) {
+			printf("%s: page %u differs\n", name, page);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	oled.on();
+	failures += check("text", drawText);
+	failures += check("fill", drawFill);
+	printf("%u pages differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks drawString, which lays out a line of text once and sends it as a single data transaction.
+ * Each line is drawn with drawString, from RAM and from PROGMEM, and must change the same GDDRAM
+ * as writing its characters one at a time, cut off at the width it is given.
+ * With an unlimited payload, the line must take no more than a command and a data transaction.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/stringcheck.cpp src/Tiny4kOLED.cpp -o stringcheck
+ * With -DTINY4KOLED_MULTIPLE_DISPLAYS, the payload can't be changed, and the transactions aren't counted.
+ */
+#include <new>
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+typedef decltype(oled) Device;
+
+static const char menu[] PROGMEM = "Menu item 12";
+static const char unknown[] PROGMEM = "caps\x7F only";
+
+static uint8_t expected[8][128];
+
+// Writes the line one character at a time, then restores the columns past the width.
+static void drawReference(const DCfont *font, const char *text, uint8_t x, uint8_t width) {
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.setFont(font);
+	oled.setCursor(x, 2);
+	while (*text) oled.write(*text++);
+	memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+	for (uint8_t page = 0; page < 8; page++) {
+		for (uint16_t col = x + width; col < 128; col++) expected[page][col] = 0x5A;
+	}
+}
+
+static uint16_t compare(const char *name, const char *from, uint8_t width) {
+	if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+		printf("%s: drawString from %s differs at width %u\n", name, from, width);
+		return 1;
+	}
+	return 0;
+}
+
+static uint16_t checkLine(const char *name, const DCfont *font, PGM_P line, uint8_t x) {
+	uint16_t failures = 0;
+	char text[32];
+	for (uint8_t i = 0; (text[i] = pgm_read_byte(line + i)); i++);
+	static const uint8_t widths[] = { 0xFF, 50, 13, 1 };
+	for (uint8_t i = 0; i < sizeof(widths) / sizeof(widths[0]); i++) {
+		drawReference(font, text, x, widths[i]);
+
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		oled.setCursor(x, 2);
+		tiny4koled_emulator_reset_counters();
+		oled.drawString(text, widths[i]);
+		failures += compare(name, "RAM", widths[i]);
+#ifndef TINY4KOLED_MULTIPLE_DISPLAYS
+		if (tiny4koled_emulator.transactions > 2) {
+			printf("%s: drawString took %u transactions\n", name, tiny4koled_emulator.transactions);
+			failures++;
+		}
+#endif
+
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		oled.setCursor(x, 2);
+		oled.drawString((DATACUTE_F_MACRO_T *)line, widths[i]);
+		failures += compare(name, "PROGMEM", widths[i]);
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+#ifndef TINY4KOLED_MULTIPLE_DISPLAYS
+	new (&oled) Device(&tiny4koled_begin_emulator, &tiny4koled_beginTransmission_emulator, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, 0);
+	beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64);
+	tiny4koled_emulator.bufferLength = 0;
+#endif
+	failures += checkLine("FONT6X8", FONT6X8, menu, 3);
+	failures += checkLine("FONT6X8P", FONT6X8P, menu, 3);
+	failures += checkLine("FONT8X16", FONT8X16, menu, 20);
+	failures += checkLine("FONT8X16P", FONT8X16P, menu, 20);
+	failures += checkLine("FONT8X16CAPS", FONT8X16CAPS, unknown, 0);
+	printf("%u lines differ\n", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks text drawn through a vertical addressing window, which sends every page of a character in one transaction.
+ * Every character of the supplied fonts is drawn with write, and a line of text with clipTextP from each start pixel,
+ * and compared with a reference that copies the font's bitmap into GDDRAM page by page.
+ * A character that follows another must be sent as a single data transaction, without any commands.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/textcheck.cpp src/Tiny4kOLED.cpp -o textcheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+static const char line[] PROGMEM = "Window {text} 42";
+
+static uint8_t expected[8][128];
+
+// Copies a character into the expected GDDRAM, followed by the font's spacing, and returns the columns it took.
+static uint8_t referenceCharacter(const DCfont *font, uint8_t c, uint8_t x, uint8_t y) {
+	uint8_t w = oled.getCharacterWidth(c);
+	const uint8_t *cPtr = &font->bitmap[oled.getCharacterDataOffset(c)];
+	for (uint8_t page = 0; page < font->height; page++) {
+		for (uint8_t col = 0; col < w; col++) {
+			expected[y + page][x + col] = pgm_read_byte(cPtr + page * w + col);
+		}
+		for (uint8_t col = 0; col < font->spacing; col++) {
+			expected[y + page][x + w + col] = 0;
+		}
+	}
+	return w + font->spacing;
+}
+
+static uint16_t compare(const char *name, const char *what, uint16_t c) {
+	if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+		printf("%s: %s 0x%02X differs\n", name, what, c);
+		return 1;
+	}
+	return 0;
+}
+
+static uint16_t checkCharacters(const char *name, const DCfont *font) {
+	uint16_t failures = 0;
+	oled.setFont(font);
+	for (uint16_t c = font->first; c <= font->last; c++) {
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+		uint8_t x = 3 + referenceCharacter(font, font->first, 3, 2);
+		referenceCharacter(font, c, x, 2);
+		oled.setCursor(3, 2);
+		oled.write(font->first);
+		tiny4koled_emulator_reset_counters();
+		oled.write(c);
+		failures += compare(name, "character", c);
+		if (tiny4koled_emulator.transactions != 1 || tiny4koled_emulator.commandBytes != 0) {
+			printf("%s: character 0x%02X took %u transactions and %u command bytes\n", name, c, tiny4koled_emulator.transactions, tiny4koled_emulator.commandBytes);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+static uint16_t checkClip(const char *name, const DCfont *font) {
+	uint16_t failures = 0;
+	uint8_t rendered[8][256];
+	uint16_t length = 0;
+	oled.setFont(font);
+	memset(expected, 0, sizeof(expected));
+	for (PGM_P p = line; pgm_read_byte(p); p++) {
+		uint8_t c = pgm_read_byte(p);
+		uint8_t columns = referenceCharacter(font, c, 0, 0);
+		for (uint8_t page = 0; page < font->height; page++) {
+			memcpy(&rendered[page][length], expected[page], columns);
+		}
+		length += columns;
+	}
+	for (uint16_t start = 0; start + 40 <= length; start++) {
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+		for (uint8_t page = 0; page < font->height; page++) {
+			memcpy(&expected[4 + page][20], &rendered[page][start], 40);
+		}
+		oled.setCursor(20, 4);
+		oled.clipTextP(start, 40, (DATACUTE_F_MACRO_T *)line);
+		failures += compare(name, "clipTextP from pixel", start);
+	}
+	return failures;
+}
+
+int main(void) {
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	failures += checkCharacters("FONT6X8", FONT6X8);
+	failures += checkCharacters("FONT6X8P", FONT6X8P);
+	failures += checkCharacters("FONT8X16", FONT8X16);
+	failures += checkCharacters("FONT8X16P", FONT8X16P);
+	failures += checkCharacters("FONT8X16DIGITS", FONT8X16DIGITS);
+	failures += checkClip("FONT6X8", FONT6X8);
+	failures += checkClip("FONT6X8P", FONT6X8P);
+	failures += checkClip("FONT8X16", FONT8X16);
+	failures += checkClip("FONT8X16P", FONT8X16P);
+	printf("%u text cases differ\n", failures);
+	return failures ? 1 : 0;
+}
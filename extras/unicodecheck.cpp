@@ -0,0 +1,130 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Checks the search for the font covering a unicode character, through the ASCII fast path,
+ * the binary search of an index, and the linear search without one.
+ * A unicode font is made of ranges of FONT6X8's glyphs, placed in several blocks and planes.
+ * Each codepoint in and around the ranges is printed as UTF-8 between two others, from the same or other blocks,
+ * with and without the index, and must match drawing the covering font's glyph directly,
+ * or nothing at all when no font covers it.
+ *
+ * This is a desktop program, built and run with the other checks by
+ *   make -C extras/host
+ * or on its own, with the host Arduino.h and avr/pgmspace.h in extras/host, e.g.
+ *   g++ -Iextras/host -Isrc extras/unicodecheck.cpp src/Tiny4kOLED.cpp -o unicodecheck
+ */
+#include "Tiny4kOLED_emulator.h"
+#include "check.h"
+
+#ifndef TINY4KOLED_NO_UNICODE
+// A font of FONT6X8's glyphs, from the glyph of character, drawn for the lower bytes first to last.
+#define GLYPHS(character, first, last) { (uint8_t *)&ssd1306xled_font6x8[((character) - 32) * 6], 6, 1, first, last, 0, 0, 0, 0, 0 }
+
+static const DCfont cyrillic = GLYPHS('0', 0x10, 0x4F);
+static const DCfont latin1 = GLYPHS('@', 0xA0, 0xBF);
+static const DCfont emoji = GLYPHS('!', 0x30, 0x4F);
+static const DCfont cyrillicHigh = GLYPHS('a', 0x60, 0x7F);
+static const DCfont katakana = GLYPHS('A', 0x40, 0x5F);
+
+static const DCUnicodeFontRef fontRefs[] = {
+	{ 0x00, 0x04, &cyrillic },
+	{ 0x00, 0x00, FONT6X8 },
+	{ 0x00, 0x00, &latin1 },
+	{ 0x01, 0xF6, &emoji },
+	{ 0x00, 0x04, &cyrillicHigh },
+	{ 0x00, 0x30, &katakana },
+};
+
+static const DCUnicodeFontIndex fontIndex[] PROGMEM = {
+	{ 0x00, 0x00, 0x20, 0x7E, 1 },
+	{ 0x00, 0x00, 0xA0, 0xBF, 2 },
+	{ 0x00, 0x04, 0x10, 0x4F, 0 },
+	{ 0x00, 0x04, 0x60, 0x7F, 4 },
+	{ 0x00, 0x30, 0x40, 0x5F, 5 },
+	{ 0x01, 0xF6, 0x30, 0x4F, 3 },
+};
+
+static const DCUnicodeFont searched = { 6, sizeof(fontRefs) / sizeof(fontRefs[0]), fontRefs, 0 };
+static const DCUnicodeFont indexed = { 6, sizeof(fontRefs) / sizeof(fontRefs[0]), fontRefs, fontIndex };
+
+static uint8_t expected[8][128];
+
+static void writeUtf8(uint32_t codepoint) {
+	if (codepoint < 0x80) {
+		oled.write(codepoint);
+	} else if (codepoint < 0x800) {
+		oled.write(0xC0 | (codepoint >> 6));
+		oled.write(0x80 | (codepoint & 0x3F));
+	} else if (codepoint < 0x10000) {
+		oled.write(0xE0 | (codepoint >> 12));
+		oled.write(0x80 | ((codepoint >> 6) & 0x3F));
+		oled.write(0x80 | (codepoint & 0x3F));
+	} else {
+		oled.write(0xF0 | (codepoint >> 18));
+		oled.write(0x80 | ((codepoint >> 12) & 0x3F));
+		oled.write(0x80 | ((codepoint >> 6) & 0x3F));
+		oled.write(0x80 | (codepoint & 0x3F));
+	}
+}
+
+// Draws the codepoint with the font that covers it, found by checking every font reference.
+static void drawReference(uint32_t codepoint) {
+	uint8_t offset = codepoint & 0xFF;
+	for (uint8_t n = 0; n < sizeof(fontRefs) / sizeof(fontRefs[0]); n++) {
+		const DCUnicodeFontRef *ref = &fontRefs[n];
+		if (ref->unicode_plane == (codepoint >> 16) && ref->unicode_block == ((codepoint >> 8) & 0xFF) &&
+		    ref->font->first <= offset && ref->font->last >= offset) {
+			oled.setFont(ref->font);
+			oled.write(offset);
+			return;
+		}
+	}
+}
+
+// Draws the codepoint between two others, each found through the unicode font, and compares it with the reference.
+static uint16_t checkCodepoint(uint32_t codepoint, uint32_t before, uint32_t after) {
+	static const DCUnicodeFont *fonts[] = { &searched, &indexed };
+	static const char *names[] = { "searched", "indexed" };
+	uint16_t failures = 0;
+	memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+	oled.setCursor(0, 3);
+	drawReference(before);
+	drawReference(codepoint);
+	drawReference(after);
+	memcpy(expected, tiny4koled_emulator.ram, sizeof(expected));
+	for (uint8_t i = 0; i < 2; i++) {
+		memset(tiny4koled_emulator.ram, 0x5A, sizeof(tiny4koled_emulator.ram));
+		oled.setUnicodeFont(fonts[i]);
+		oled.setCursor(0, 3);
+		writeUtf8(before);
+		writeUtf8(codepoint);
+		writeUtf8(after);
+		if (memcmp(expected, tiny4koled_emulator.ram, sizeof(expected)) != 0) {
+			printf("%s: U+%04X after U+%04X differs\n", names[i], codepoint, before);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+int main(void) {
+	static const uint32_t blocks[] = { 0x0000, 0x0400, 0x3000, 0x1F600, 0x1F700, 0x0500 };
+	uint16_t failures = 0;
+	if (!beginDisplay(128, 64, sizeof(tiny4koled_init_128x64), tiny4koled_init_128x64)) return skipped("as it needs a 128x64 display");
+	for (uint8_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+		for (uint16_t offset = 0; offset < 0x100; offset++) {
+			uint32_t codepoint = blocks[b] | offset;
+			if (codepoint <= ' ') continue;
+			failures += checkCodepoint(codepoint, 'A', 'z');
+			failures += checkCodepoint(codepoint, 0x0420, 0x1F635);
+			failures += checkCodepoint(codepoint, 0x3041, 0x00A5);
+		}
+	}
+	printf("%u codepoints differ\n", failures);
+	return failures ? 1 : 0;
+}
+#else
+int main(void) {
+	return skipped("as TINY4KOLED_NO_UNICODE leaves out unicode fonts");
+}
+#endif
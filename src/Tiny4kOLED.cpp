@@ -18,43 +18,193 @@
 
 // ----------------------------------------------------------------------------
 
+#ifdef TINY4KOLED_WIDTH
+// The display's geometry is fixed when it is defined for the whole build, so that the compiler folds it into the code.
+#ifndef TINY4KOLED_HEIGHT
+#error TINY4KOLED_HEIGHT must be defined along with TINY4KOLED_WIDTH
+#endif
+#ifndef TINY4KOLED_OFFSET_X
+#define TINY4KOLED_OFFSET_X ((SSD1306_COLUMNS - TINY4KOLED_WIDTH) >> 1)
+#endif
+#ifndef TINY4KOLED_OFFSET_Y
+#define TINY4KOLED_OFFSET_Y 0
+#endif
+static const uint8_t oledOffsetX = TINY4KOLED_OFFSET_X; // pixels
+static const uint8_t oledWidth = TINY4KOLED_WIDTH; // pixels
+static const uint8_t oledPages = TINY4KOLED_HEIGHT >> 3;
+// Console mode scrolls the page offset
+#define oledOffsetY ((uint8_t)(((TINY4KOLED_OFFSET_Y >> 3) + consoleScroll) & 0x07))
+#else
 static uint8_t oledOffsetX = 0, oledOffsetY = 0; // pixels and pages
 static uint8_t oledWidth = SSD1306_COLUMNS; // pixels and pages
 static uint8_t oledPages = SSD1306_PAGES;
+#endif
 static const DCUnicodeFont *oledUnicodeFont = 0;
 static uint8_t unicodeFontNum = 0;
+#define NO_UNICODE_FONT 0xFF
+static uint8_t asciiFontNum = NO_UNICODE_FONT; // the unicode font's font for printable ASCII characters
 static const DCfont *oledFont = 0;
 static uint8_t oledX = 0, oledY = 0;
 static uint8_t renderingFrame = 0xB0, drawingFrame = 0x40;
-static uint8_t doubleSize = 0;
+#ifdef TINY4KOLED_ONLY_ORIGINAL_SIZE
+static const uint8_t fontScale = 1;
+#else
+static uint8_t fontScale = 1; // 1 to 4, the multiple of the font's size that text is drawn at
+#endif
 static uint8_t characterSpacing = 0;
 static DCUnicodeCodepoint unicodeCodepoint = { 0 };
 static uint8_t utf8Continuation = 0;
 
 static void (*wireBeginFn)(void);
-static bool (*wireBeginTransmissionFn)(void);
-static bool (*wireWriteFn)(uint8_t byte);
-static uint8_t (*wireEndTransmissionFn)(void);
 
+static SSD1306Transport wire;
+
+// Printing dispatches through decodeFn and renderFn, which are selected by the setFont methods.
+// Defining TINY4KOLED_NO_UNICODE or TINY4KOLED_ONLY_ORIGINAL_SIZE for the whole build fixes the decoder or the renderer,
+// which is then called directly, and leaves out the methods that would select the others.
+#ifdef TINY4KOLED_NO_UNICODE
+#define SSD1306_DECODE(c) if (oledFont) decodeAsciiInternal(c)
+#else
 static void (SSD1306Device::* decodeFn)(uint8_t c) = 0;
+#define SSD1306_DECODE(c) if (decodeFn) (this->*decodeFn)(c)
+#endif
+#ifdef TINY4KOLED_ONLY_ORIGINAL_SIZE
+#define SSD1306_RENDER(c) renderOriginalSize(c)
+#else
 static void (SSD1306Device::* renderFn)(uint8_t c) = 0;
+#define SSD1306_RENDER(c) (this->*renderFn)(c)
+#endif
 static uint8_t (*combineFn)(uint8_t x, uint8_t y, uint8_t b) = 0;
 static uint8_t writesSinceSetCursor = 0;
 
+// Text is rendered in vertical addressing mode, into a window of pages starting at the cursor.
+// The window is left open while consecutive glyphs are written on the same line,
+// and is closed by the next page addressing mode operation.
+static uint8_t windowPages = 0; // 0 when the controller is in page addressing mode
+static uint8_t windowTop = 0;
+static bool pointerAtCursor = false; // true when the controller's address pointer is known to be at oledX, oledY
+
+// Moving the cursor only records its position. The addressing commands are sent before the next data is.
+static bool cursorPending = false; // true when the cursor has moved since it was sent to the controller
+
+// In console mode, a new line past the bottom scrolls the display by changing its start line,
+// and the pages scrolled are added to the page offset, so that drawing follows the scrolled display.
+static bool consoleMode = false;
+static uint8_t consoleScroll = 0; // the number of pages scrolled, included in oledOffsetY
+
+static uint16_t transactionBytes = 0;
+static uint8_t transactionControl = SSD1306_COMMAND;
+static uint8_t commandArguments = 0; // the argument bytes still to follow the command being sent
+
+// While a frame buffer is attached, the transport is swapped for one that writes into the buffer.
+// The display's own transport is swapped back in to flush the buffer.
+static DCFrameBuffer *frameBuffer = 0;
+static SSD1306Transport otherTransport;
+static bool capturing = false; // true while bytes are being written into the frame buffer
+
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+uint8_t tiny4koled_address = SSD1306;
+static SSD1306Device *activeDevice = 0; // the display whose state is held in the statics above
+// Each public method first selects its display, unless it is already selected.
+#define SSD1306_SELECT() if (this != activeDevice) select()
+#else
+#define SSD1306_SELECT()
+#endif
+
+static void ssd1306_swap_transport(void) {
+	SSD1306Transport transport = wire;
+	wire = otherTransport;
+	otherTransport = transport;
+	capturing = !capturing;
+}
+
+#ifdef TINY4KOLED_STATS
+static DCTransferStats transferStats;
+
+static void ssd1306_count_payload(uint16_t count) {
+	if (capturing) return;
+	transferStats.bytes += count;
+	if (transactionControl & SSD1306_DATA) transferStats.dataBytes += count;
+	else transferStats.commandBytes += count;
+}
+#endif
+
 static void ssd1306_begin(void) {
 	wireBeginFn();
 }
 
 static void ssd1306_send_start(void) {
-	wireBeginTransmissionFn();
+#ifdef TINY4KOLED_STATS
+	if (!capturing) transferStats.transactions++;
+#endif
+	wire.beginTransmission();
+	transactionBytes = 0;
 }
 
-static bool ssd1306_send_byte(uint8_t byte) {
-	return wireWriteFn(byte);
+static void ssd1306_send_stop(void) {
+	wire.endTransmission();
+}
+
+// Number of argument bytes following each multi-byte command
+static uint8_t ssd1306_argument_count(uint8_t command) {
+	switch (command) {
+		case 0x20: case 0x23: case 0x81: case 0x8D: case 0xA8: case 0xAD:
+		case 0xD3: case 0xD5: case 0xD6: case 0xD9: case 0xDA: case 0xDB:
+			return 1;
+		case 0x21: case 0x22: case 0xA3:
+			return 2;
+		case 0x29: case 0x2A:
+			return 5;
+		case 0x26: case 0x27: case 0x2C: case 0x2D:
+			return 6;
+	}
+	return 0;
 }
 
-static void ssd1306_send_stop(void) {
-	wireEndTransmissionFn();
+static void ssd1306_send_byte(uint8_t byte);
+
+// Ends the current transaction and starts another of the same type.
+static void ssd1306_send_restart(void) {
+	uint8_t arguments = commandArguments;
+	ssd1306_send_stop();
+	ssd1306_send_start();
+	ssd1306_send_byte(transactionControl);
+	commandArguments = arguments;
+}
+
+static void ssd1306_send_byte(uint8_t byte) {
+	if (transactionBytes == 0) {
+		// The first byte of each transaction is the control byte, which selects commands or data.
+		transactionControl = byte;
+		commandArguments = 0;
+	}
+	else {
+		// A command is kept in one transaction with its arguments, rather than being split at the transport's buffer size,
+		// unless it would not fit in a transaction of its own.
+		uint8_t needed = 1;
+		if (transactionControl == SSD1306_COMMAND) {
+			if (commandArguments) {
+				commandArguments--;
+			}
+			else {
+				commandArguments = ssd1306_argument_count(byte);
+				needed += commandArguments;
+			}
+		}
+		if (wire.maxPayload && transactionBytes + needed > wire.maxPayload && (transactionBytes > 1 || needed == 1)) {
+			ssd1306_send_restart();
+		}
+	}
+	if (!wire.write(byte)) {
+		// The transport's buffer was full before the declared maximum payload.
+		ssd1306_send_restart();
+		wire.write(byte);
+	}
+	transactionBytes++;
+#ifdef TINY4KOLED_STATS
+	if (transactionBytes > 1) ssd1306_count_payload(1);
+	else if (!capturing) transferStats.bytes++;
+#endif
 }
 
 static void ssd1306_send_command_start(void) {
@@ -67,22 +217,325 @@ static void ssd1306_send_data_start(void) {
 	ssd1306_send_byte(SSD1306_DATA);
 }
 
-static void ssd1306_send_command_byte(uint8_t byte) {
-	if (ssd1306_send_byte(byte) == 0) {
+// The number of bytes, up to count, that still fit in the current transaction.
+static uint16_t ssd1306_send_room(uint16_t count) {
+	if (wire.maxPayload) {
+		uint16_t room = wire.maxPayload - transactionBytes;
+		if (count > room) return room;
+	}
+	return count;
+}
+
+#ifdef TINY4KOLED_MIXED_TRANSACTIONS
+// Mixed transactions start with commands, each preceded by a continuation (Co=1) control byte,
+// followed by data, so that positioning and the data written there share one transaction.
+static void ssd1306_send_mixed_control(uint8_t control) {
+	// A control byte must be followed by its byte in the same transaction.
+	if (ssd1306_send_room(2) < 2) {
 		ssd1306_send_stop();
-		ssd1306_send_command_start();
-		ssd1306_send_byte(byte);
+		ssd1306_send_start();
+	}
+	ssd1306_send_byte(control);
+#ifdef TINY4KOLED_STATS
+	// Only the first byte of a transaction is counted as a control byte
+	if (!capturing && transactionBytes > 1) transferStats.commandBytes--;
+#endif
+	transactionControl = control;
+}
+
+static void ssd1306_send_mixed_command(uint8_t command) {
+	ssd1306_send_mixed_control(0x80);
+	ssd1306_send_byte(command);
+}
+#endif
+
+// Sends count copies of a byte, restarting the data transaction whenever the transport's buffer fills.
+static void ssd1306_send_data_repeat(uint8_t byte, uint16_t count) {
+	if (!wire.repeat) {
+		while (count--) ssd1306_send_byte(byte);
+		return;
+	}
+	while (count) {
+		uint16_t sent = (*wire.repeat)(byte, ssd1306_send_room(count));
+		transactionBytes += sent;
+#ifdef TINY4KOLED_STATS
+		ssd1306_count_payload(sent);
+#endif
+		count -= sent;
+		if (count) {
+			ssd1306_send_restart();
+		}
+	}
+}
+
+// Sends a block of bytes from RAM or PROGMEM, restarting the transaction whenever the transport's buffer fills.
+static void ssd1306_send_block(const uint8_t *bytes, uint16_t count, bool progmem) {
+	uint16_t (*writeBlockFn)(const uint8_t *bytes, uint16_t count) = progmem ? wire.writeBlockP : wire.writeBlock;
+	// Blocks of commands, such as the init sequences, are sent a byte at a time, so that no command is split.
+	if (!writeBlockFn || transactionControl == SSD1306_COMMAND) {
+		for (uint16_t i = 0; i < count; i++) {
+			ssd1306_send_byte(progmem ? pgm_read_byte(&bytes[i]) : bytes[i]);
+		}
+		return;
+	}
+	while (count) {
+		uint16_t sent = (*writeBlockFn)(bytes, ssd1306_send_room(count));
+		transactionBytes += sent;
+#ifdef TINY4KOLED_STATS
+		ssd1306_count_payload(sent);
+#endif
+		bytes += sent;
+		count -= sent;
+		if (count) {
+			ssd1306_send_restart();
+		}
 	}
 }
 
 static void ssd1306_send_data_byte(uint8_t byte) {
 	if (combineFn) byte = (*combineFn)(oledX + writesSinceSetCursor, oledY, byte);
-	if (ssd1306_send_byte(byte) == 0) {
+	ssd1306_send_byte(byte);
+	writesSinceSetCursor++;
+}
+
+static void ssd1306_send_cursor(uint8_t x, uint8_t y) {
+	ssd1306_send_byte(renderingFrame | ((y + oledOffsetY) & 0x07));
+	ssd1306_send_byte(0x10 | (((x + oledOffsetX) & 0xf0) >> 4));
+	ssd1306_send_byte((x + oledOffsetX) & 0x0f);
+}
+
+static void ssd1306_send_window_close(void) {
+	ssd1306_send_byte(0x20);
+	ssd1306_send_byte(0x02);
+	ssd1306_send_byte(0x22);
+	ssd1306_send_byte(0x00);
+	ssd1306_send_byte(0x07);
+	windowPages = 0;
+}
+
+static void ssd1306_move_cursor(uint8_t x, uint8_t y) {
+	if (!pointerAtCursor || x != oledX || y != oledY) {
+		cursorPending = true;
+		pointerAtCursor = false;
+	}
+	oledX = x;
+	oledY = y;
+	writesSinceSetCursor = 0;
+}
+
+// The cursor is relative to the render frame and the display's geometry,
+// so changing them moves it on the controller, even when its logical position is unchanged.
+static void ssd1306_cursor_relocated(void) {
+	pointerAtCursor = false;
+	cursorPending = true;
+}
+
+// Returns the controller to page addressing mode, sending the cursor if it has moved.
+static void ssd1306_send_pending_cursor(void) {
+	if (windowPages == 0 && !cursorPending) return;
+	ssd1306_send_command_start();
+	if (windowPages) {
+		ssd1306_send_window_close();
+	}
+	ssd1306_send_cursor(oledX, oledY);
+	ssd1306_send_stop();
+	cursorPending = false;
+	pointerAtCursor = true;
+}
+
+// Starts a data transaction in page addressing mode, sending the cursor first if it has moved.
+static void ssd1306_send_cursor_data_start(void) {
+#ifdef TINY4KOLED_MIXED_TRANSACTIONS
+	if (windowPages == 0 && cursorPending) {
+		ssd1306_send_start();
+		ssd1306_send_mixed_command(renderingFrame | ((oledY + oledOffsetY) & 0x07));
+		ssd1306_send_mixed_command(0x10 | (((oledX + oledOffsetX) & 0xf0) >> 4));
+		ssd1306_send_mixed_command((oledX + oledOffsetX) & 0x0f);
+		ssd1306_send_mixed_control(SSD1306_DATA);
+		cursorPending = false;
+		pointerAtCursor = true;
+		return;
+	}
+#endif
+	ssd1306_send_pending_cursor();
+	ssd1306_send_data_start();
+}
+
+// Starts a data transaction that writes to a window from the cursor, to the right edge, and the given number of pages down.
+static void ssd1306_send_window_start(uint8_t pages) {
+	uint8_t top = (renderingFrame | ((oledY + oledOffsetY) & 0x07)) & 0x07;
+	if (windowPages != pages || windowTop != top || cursorPending) {
+		ssd1306_send_command_start();
+		if (windowPages) {
+			ssd1306_send_byte(0x20);
+			ssd1306_send_byte(0x02);
+		}
+		if (windowPages || !pointerAtCursor) {
+			ssd1306_send_cursor(oledX, oledY);
+			cursorPending = false;
+			pointerAtCursor = true;
+		}
+		ssd1306_send_byte(0x20);
+		ssd1306_send_byte(0x01);
+		ssd1306_send_byte(0x22);
+		ssd1306_send_byte(top);
+		ssd1306_send_byte((top + pages - 1) & 0x07);
 		ssd1306_send_stop();
-		ssd1306_send_data_start();
-		ssd1306_send_byte(byte);
+		windowPages = pages;
+		windowTop = top;
 	}
-	writesSinceSetCursor++;
+	ssd1306_send_data_start();
+}
+
+static void ssd1306_send_window_byte(uint8_t byte, uint8_t page) {
+	if (combineFn) byte = (*combineFn)(oledX, oledY + page, byte);
+	ssd1306_send_byte(byte);
+}
+
+// Sends columns of page ordered bitmap data, each column top page first, advancing the cursor.
+// A null bitmap sends blank columns.
+static void ssd1306_send_window_columns(const uint8_t *bitmap, uint8_t stride, uint8_t columns, uint8_t pages) {
+	if (!combineFn) {
+		if (!bitmap) {
+			ssd1306_send_data_repeat(0, columns * pages);
+			oledX += columns;
+			return;
+		}
+		if (pages == 1) {
+			ssd1306_send_block(bitmap, columns, true);
+			oledX += columns;
+			return;
+		}
+	}
+	for (uint8_t col = 0; col < columns; col++) {
+		const uint8_t *p = bitmap + col;
+		for (uint8_t page = 0; page < pages; page++) {
+			ssd1306_send_window_byte(bitmap ? pgm_read_byte(p) : 0, page);
+			p += stride;
+		}
+		oledX++;
+	}
+}
+
+// Compressed glyphs are read a bit at a time from PROGMEM, and decoded a byte at a time as they are sent.
+static const uint8_t *glyphData;
+static uint8_t glyphBits, glyphMask;
+
+static uint8_t ssd1306_glyph_bit(void) {
+	if (glyphMask == 0) {
+		glyphBits = pgm_read_byte(glyphData++);
+		glyphMask = 0x80;
+	}
+	uint8_t bit = (glyphBits & glyphMask) ? 1 : 0;
+	glyphMask >>= 1;
+	return bit;
+}
+
+// Decodes the next canonical Huffman code.
+static uint8_t ssd1306_glyph_byte(void) {
+	const DCFontCompression *z = oledFont->compression;
+	uint16_t code = 0, first = 0, index = 0;
+	for (uint8_t length = 0; length < z->maxLength; length++) {
+		code |= ssd1306_glyph_bit();
+		uint8_t count = pgm_read_byte(&z->lengthCounts[length]);
+		if (code - first < count) return pgm_read_byte(&z->symbols[index + code - first]);
+		index += count;
+		first = (first + count) << 1;
+		code <<= 1;
+	}
+	return 0;
+}
+
+// Moves to the start of a character's glyph, from the checkpoint before it.
+static void ssd1306_glyph_start(uint8_t c) {
+	uint16_t c_index = (uint16_t)c - oledFont->first;
+	uint16_t bit = pgm_read_word(&(oledFont->compression->checkpoints[c_index >> 4]));
+	glyphData = &(oledFont->bitmap[bit >> 3]);
+	glyphBits = pgm_read_byte(glyphData++);
+	glyphMask = 0x80 >> (bit & 0x07);
+	uint16_t skip = 0;
+	for (uint16_t pre_c = c_index & ~0x0F; pre_c < c_index; pre_c++) {
+		skip += oledFont->width ? oledFont->width : pgm_read_byte(&(oledFont->widths[pre_c]));
+	}
+	skip *= oledFont->height;
+	while (skip--) ssd1306_glyph_byte();
+}
+
+// Sends columns of the current glyph, as ssd1306_send_window_columns does for uncompressed bitmaps.
+static void ssd1306_send_glyph_columns(uint8_t columns, uint8_t pages) {
+	for (uint8_t col = 0; col < columns; col++) {
+		for (uint8_t page = 0; page < pages; page++) {
+			ssd1306_send_window_byte(ssd1306_glyph_byte(), page);
+		}
+		oledX++;
+	}
+}
+
+// Compressed bitmaps are a sequence of tokens, each starting with a byte whose top two bits give its type:
+// 00nnnnnn: n + 1 literal bytes follow
+// 01nnnnnn b: the byte b repeated n + 2 times
+// 10nnnnnn nnnnnnnn: n + 1 zero bytes, n being 14 bits
+// 11nnnnnn hi lo: n + 4 bytes decoded from the token at offset hi lo, which must not be a back reference.
+// See extras/bitmapcompress.py
+#define BITMAP_LITERAL 0x00
+#define BITMAP_RUN 0x40
+#define BITMAP_ZEROS 0x80
+#define BITMAP_BACK_REFERENCE 0xC0
+static const uint8_t *bitmapStart, *bitmapNext, *bitmapReturn;
+static uint16_t bitmapCount; // bytes left in the current token
+static uint16_t bitmapReferenceCount; // bytes left in the current back reference
+static uint8_t bitmapToken, bitmapRunByte;
+
+static void ssd1306_bitmap_start(const uint8_t *tokens) {
+	bitmapStart = tokens;
+	bitmapNext = tokens;
+	bitmapReturn = 0;
+	bitmapCount = 0;
+}
+
+// Reads the next token, when the current one, or the back reference it is part of, is finished.
+static void ssd1306_bitmap_token(void) {
+	if (bitmapReturn && bitmapReferenceCount == 0) {
+		bitmapNext = bitmapReturn;
+		bitmapReturn = 0;
+	}
+	else if (bitmapCount) return;
+	uint8_t token = pgm_read_byte(bitmapNext++);
+	if ((token & 0xC0) == BITMAP_BACK_REFERENCE) {
+		bitmapReferenceCount = (token & 0x3F) + 4;
+		uint16_t offset = ((uint16_t)pgm_read_byte(bitmapNext) << 8) | pgm_read_byte(bitmapNext + 1);
+		bitmapReturn = bitmapNext + 2;
+		bitmapNext = bitmapStart + offset;
+		token = pgm_read_byte(bitmapNext++);
+	}
+	bitmapToken = token & 0xC0;
+	bitmapCount = (token & 0x3F) + 1;
+	bitmapRunByte = 0;
+	if (bitmapToken == BITMAP_RUN) {
+		bitmapCount++;
+		bitmapRunByte = pgm_read_byte(bitmapNext++);
+	}
+	else if (bitmapToken == BITMAP_ZEROS) {
+		bitmapCount = (((uint16_t)(token & 0x3F) << 8) | pgm_read_byte(bitmapNext++)) + 1;
+	}
+}
+
+// The number of zero bytes that can be skipped from here, without reading another token.
+static uint16_t ssd1306_bitmap_zeros(void) {
+	if (bitmapToken == BITMAP_LITERAL || bitmapRunByte) return 0;
+	if (bitmapReturn && bitmapReferenceCount < bitmapCount) return bitmapReferenceCount;
+	return bitmapCount;
+}
+
+static void ssd1306_bitmap_skip(uint16_t count) {
+	bitmapCount -= count;
+	if (bitmapReturn) bitmapReferenceCount -= count;
+}
+
+static uint8_t ssd1306_bitmap_byte(void) {
+	ssd1306_bitmap_token();
+	ssd1306_bitmap_skip(1);
+	return (bitmapToken == BITMAP_LITERAL) ? pgm_read_byte(bitmapNext++) : bitmapRunByte;
 }
 
 static void ssd1306_send_command(uint8_t command) {
@@ -129,118 +582,417 @@ static void ssd1306_send_command7(uint8_t command1, uint8_t command2, uint8_t co
 	ssd1306_send_stop();
 }
 
-static uint8_t invertByte(uint8_t x, uint8_t y, uint8_t byte) {
-	return byte ^ 0xff;
+// ----------------------------------------------------------------------------
+
+// The frame buffer follows the commands that move the controller's address pointer,
+// and stores data bytes where the controller would have. Other commands are passed on to the display.
+
+static void ssd1306_capture_command(void) {
+	DCFrameBuffer *fb = frameBuffer;
+	uint8_t c = fb->command[0];
+	if (c <= 0x0F) {
+		fb->column = (fb->column & 0x70) | c;
+	} else if (c <= 0x17) {
+		fb->column = (fb->column & 0x0F) | ((c & 0x07) << 4);
+	} else if (c >= 0xB0 && c <= 0xB7) {
+		fb->page = c & 0x07;
+	} else if (c == 0x20) {
+		if ((fb->command[1] & 0x03) != 0x03) fb->addressingMode = fb->command[1] & 0x03;
+	} else if (c == 0x21) {
+		fb->columnStart = fb->command[1] & 0x7F;
+		fb->columnEnd = fb->command[2] & 0x7F;
+		fb->column = fb->columnStart;
+	} else if (c == 0x22) {
+		fb->pageStart = fb->command[1] & 0x07;
+		fb->pageEnd = fb->command[2] & 0x07;
+		fb->page = fb->pageStart;
+	} else {
+		otherTransport.beginTransmission();
+		otherTransport.write(SSD1306_COMMAND);
+		for (uint8_t i = 0; i < fb->commandLength; i++) {
+			otherTransport.write(fb->command[i]);
+		}
+		otherTransport.endTransmission();
+#ifdef TINY4KOLED_STATS
+		transferStats.transactions++;
+		transferStats.bytes += 1 + fb->commandLength;
+		transferStats.commandBytes += fb->commandLength;
+#endif
+	}
+}
+
+static void ssd1306_capture_data(uint8_t byte) {
+	DCFrameBuffer *fb = frameBuffer;
+	uint8_t row = fb->page - fb->firstPage;
+	uint8_t col = fb->column - fb->firstColumn;
+	if (row < fb->pages && col < fb->columns) {
+		uint8_t *p = fb->buffer + row * fb->columns + col;
+		if (fb->composite) byte |= *p;
+		if (*p != byte) {
+			*p = byte;
+			if (fb->column < fb->dirtyStart[row]) fb->dirtyStart[row] = fb->column;
+			if (fb->column > fb->dirtyEnd[row]) fb->dirtyEnd[row] = fb->column;
+		}
+	}
+	switch (fb->addressingMode) {
+		case 0:
+			if (fb->column >= fb->columnEnd) {
+				fb->column = fb->columnStart;
+				fb->page = (fb->page >= fb->pageEnd) ? fb->pageStart : fb->page + 1;
+			} else {
+				fb->column++;
+			}
+			break;
+		case 1:
+			if (fb->page >= fb->pageEnd) {
+				fb->page = fb->pageStart;
+				fb->column = (fb->column >= fb->columnEnd) ? fb->columnStart : fb->column + 1;
+			} else {
+				fb->page++;
+			}
+			break;
+		default:
+			fb->column = (fb->column >= fb->columnEnd) ? fb->columnStart : fb->column + 1;
+			break;
+	}
 }
 
-SSD1306Device::SSD1306Device(void (*wireBeginFunc)(void), bool (*wireBeginTransmissionFunc)(void), bool (*wireWriteFunc)(uint8_t byte), uint8_t (*wireEndTransmissionFunc)(void)) {
-	wireBeginFn = wireBeginFunc;
-	wireBeginTransmissionFn = wireBeginTransmissionFunc;
-	wireWriteFn = wireWriteFunc;
-	wireEndTransmissionFn = wireEndTransmissionFunc;
+static bool ssd1306_capture_beginTransmission(void) {
+	frameBuffer->controlExpected = true;
+	frameBuffer->commandLength = 0;
+	return true;
 }
 
+static bool ssd1306_capture_write(uint8_t byte) {
+	DCFrameBuffer *fb = frameBuffer;
+	if (fb->controlExpected) {
+		fb->control = byte;
+		fb->controlExpected = false;
+		return true;
+	}
+	if (fb->control & SSD1306_DATA) {
+		ssd1306_capture_data(byte);
+	} else {
+		if (fb->commandLength == 0) {
+			fb->commandExpected = ssd1306_argument_count(byte);
+		}
+		fb->command[fb->commandLength++] = byte;
+		if (fb->commandLength > fb->commandExpected) {
+			ssd1306_capture_command();
+			fb->commandLength = 0;
+		}
+	}
+	// Co=1 means only the next byte is of the type selected by D/C#, and is followed by another control byte.
+	if (fb->control & 0x80) fb->controlExpected = true;
+	return true;
+}
+
+static uint8_t ssd1306_capture_endTransmission(void) {
+	return 0;
+}
+
+// Marks the columns from start to end of every page in the frame buffer as needing to be flushed.
+static void ssd1306_frame_buffer_dirty(uint8_t start, uint8_t end) {
+	for (uint8_t row = 0; row < frameBuffer->pages; row++) {
+		frameBuffer->dirtyStart[row] = start;
+		frameBuffer->dirtyEnd[row] = end;
+	}
+}
+
+// Swaps in the frame buffer's transport, with the controller's address pointer at the cursor, in page addressing mode.
+static void ssd1306_start_capture(void) {
+	DCFrameBuffer *fb = frameBuffer;
+	fb->addressingMode = 2;
+	fb->columnStart = 0;
+	fb->columnEnd = SSD1306_COLUMNS - 1;
+	fb->pageStart = 0;
+	fb->pageEnd = 7;
+	fb->column = (oledX + oledOffsetX) & 0x7F;
+	fb->page = (renderingFrame | ((oledY + oledOffsetY) & 0x07)) & 0x07;
+	fb->commandLength = 0;
+	windowPages = 0;
+	cursorPending = false;
+	pointerAtCursor = true;
+
+	otherTransport.beginTransmission = &ssd1306_capture_beginTransmission;
+	otherTransport.write = &ssd1306_capture_write;
+	otherTransport.endTransmission = &ssd1306_capture_endTransmission;
+	otherTransport.repeat = 0;
+	otherTransport.writeBlock = 0;
+	otherTransport.writeBlockP = 0;
+	otherTransport.maxPayload = 0;
+	ssd1306_swap_transport();
+}
+
+// ----------------------------------------------------------------------------
+
+static uint8_t invertByte(uint8_t /*x*/, uint8_t /*y*/, uint8_t byte) {
+	return byte ^ 0xff;
+}
+
+SSD1306Device::SSD1306Device(void (*wireBeginFunc)(void), bool (*wireBeginTransmissionFunc)(void), bool (*wireWriteFunc)(uint8_t byte), uint8_t (*wireEndTransmissionFunc)(void), uint16_t (*wireRepeatFunc)(uint8_t byte, uint16_t count), uint16_t (*wireWriteBlockFunc)(const uint8_t *bytes, uint16_t count), uint16_t (*wireWriteBlockPFunc)(const uint8_t *bytes, uint16_t count), uint16_t wireMaxPayloadBytes) {
+	void (**beginFn)(void) = &wireBeginFn;
+	SSD1306Transport *transport = &wire;
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+	// The first display's state starts in the statics, and the others' in their saved state.
+	if (activeDevice) {
+		beginFn = &savedState.wireBeginFn;
+		transport = &savedState.wire;
+	}
+	else {
+		activeDevice = this;
+	}
+#endif
+	*beginFn = wireBeginFunc;
+	transport->beginTransmission = wireBeginTransmissionFunc;
+	transport->write = wireWriteFunc;
+	transport->endTransmission = wireEndTransmissionFunc;
+	transport->repeat = wireRepeatFunc;
+	transport->writeBlock = wireWriteBlockFunc;
+	transport->writeBlockP = wireWriteBlockPFunc;
+	transport->maxPayload = wireMaxPayloadBytes;
+}
+
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+// Saves the state of the selected display, and loads this display's state in its place.
+// The bus must not be in the middle of a transaction, such as between startData and endData.
+#define SSD1306_SWITCH(name) saved.name = name; name = savedState.name
+void SSD1306Device::select(void) {
+	SavedState &saved = activeDevice->savedState;
+	SSD1306_SWITCH(tiny4koled_address);
+	SSD1306_SWITCH(wireBeginFn);
+	SSD1306_SWITCH(wire);
+	SSD1306_SWITCH(otherTransport);
+	SSD1306_SWITCH(capturing);
+	SSD1306_SWITCH(frameBuffer);
+#ifndef TINY4KOLED_WIDTH
+	SSD1306_SWITCH(oledOffsetX);
+	SSD1306_SWITCH(oledOffsetY);
+	SSD1306_SWITCH(oledWidth);
+	SSD1306_SWITCH(oledPages);
+#endif
+	SSD1306_SWITCH(oledUnicodeFont);
+	SSD1306_SWITCH(unicodeFontNum);
+	SSD1306_SWITCH(asciiFontNum);
+	SSD1306_SWITCH(oledFont);
+	SSD1306_SWITCH(oledX);
+	SSD1306_SWITCH(oledY);
+	SSD1306_SWITCH(renderingFrame);
+	SSD1306_SWITCH(drawingFrame);
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	SSD1306_SWITCH(fontScale);
+#endif
+	SSD1306_SWITCH(characterSpacing);
+	SSD1306_SWITCH(unicodeCodepoint);
+	SSD1306_SWITCH(utf8Continuation);
+#ifndef TINY4KOLED_NO_UNICODE
+	SSD1306_SWITCH(decodeFn);
+#endif
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	SSD1306_SWITCH(renderFn);
+#endif
+	SSD1306_SWITCH(combineFn);
+	SSD1306_SWITCH(writesSinceSetCursor);
+	SSD1306_SWITCH(windowPages);
+	SSD1306_SWITCH(windowTop);
+	SSD1306_SWITCH(pointerAtCursor);
+	SSD1306_SWITCH(cursorPending);
+	SSD1306_SWITCH(consoleMode);
+	SSD1306_SWITCH(consoleScroll);
+	activeDevice = this;
+}
+
+void SSD1306Device::setAddress(uint8_t address) {
+	SSD1306_SELECT();
+	tiny4koled_address = address;
+}
+#endif
+
 void SSD1306Device::begin(void) {
+	SSD1306_SELECT();
 	begin(sizeof(tiny4koled_init_128x32r), tiny4koled_init_128x32r);
 }
 
 void SSD1306Device::begin(uint8_t init_sequence_length, const uint8_t init_sequence []) {
+	SSD1306_SELECT();
 	ssd1306_begin();
+#ifndef TINY4KOLED_WIDTH
+	oledOffsetY = (oledOffsetY - consoleScroll) & 0x07;
+#endif
+	consoleScroll = 0;
+	windowPages = 0;
+	pointerAtCursor = false;
+	cursorPending = true;
 
 	ssd1306_send_command_start();
-	for (uint8_t i = 0; i < init_sequence_length; i++) {
-		ssd1306_send_command_byte(pgm_read_byte(&init_sequence[i]));
-	}
+	ssd1306_send_block(init_sequence, init_sequence_length, true);
 	ssd1306_send_stop();
 }
 
+#ifndef TINY4KOLED_WIDTH
+// With a fixed geometry, the methods that would change it are deleted.
 void SSD1306Device::begin(uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) {
+	SSD1306_SELECT();
 	oledOffsetX = (128 - width) >> 1;
 	oledOffsetY = 0;
 	oledWidth = width;
 	oledPages = height >> 3;
+	consoleScroll = 0;
 	begin(init_sequence_length,init_sequence);
 }
 
 void SSD1306Device::begin(uint8_t xOffset, uint8_t yOffset, uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) {
+	SSD1306_SELECT();
 	oledOffsetX = xOffset;
 	oledOffsetY = yOffset >> 3;
 	oledWidth = width;
 	oledPages = height >> 3;
+	consoleScroll = 0;
 	begin(init_sequence_length,init_sequence);
 }
 
 void SSD1306Device::setPages(uint8_t pages) {
+	SSD1306_SELECT();
 	oledPages = pages;
+	ssd1306_cursor_relocated();
 }
 
 void SSD1306Device::setWidth(uint8_t width) {
+	SSD1306_SELECT();
 	oledWidth = width;
+	ssd1306_cursor_relocated();
 }
 
 void SSD1306Device::setHeight(uint8_t height) {
+	SSD1306_SELECT();
 	oledPages = height >> 3;
+	ssd1306_cursor_relocated();
 }
 
 void SSD1306Device::setOffset(uint8_t xOffset, uint8_t yOffset) {
+	SSD1306_SELECT();
 	oledOffsetX = xOffset;
 	oledOffsetY = yOffset >> 3;
+	consoleScroll = 0;
+	ssd1306_cursor_relocated();
 }
+#endif
 
 void SSD1306Device::setRotation(uint8_t rotation) {
+	SSD1306_SELECT();
 	uint8_t rotationBit = (rotation & 0x01);
 	ssd1306_send_command2(0xC0 | (rotationBit << 3), 0xA0 | rotationBit);
 }
 
+#ifndef TINY4KOLED_NO_UNICODE
+// Also finds the font that covers the printable ASCII characters, if there is one, so that they can be selected without a search.
+static void ssd1306_set_unicode_font(const DCUnicodeFont *unicode_font) {
+	oledUnicodeFont = unicode_font;
+	unicodeFontNum = 0;
+	asciiFontNum = NO_UNICODE_FONT;
+	for (uint8_t fontNum = 0; fontNum < unicode_font->num_fonts; fontNum++) {
+		const DCUnicodeFontRef *ref = &unicode_font->fonts[fontNum];
+		if (ref->unicode_plane == 0 && ref->unicode_block == 0 && ref->font->first <= '!' && ref->font->last >= '~') {
+			asciiFontNum = fontNum;
+			break;
+		}
+	}
+}
+#endif
+
 void SSD1306Device::setFont(const DCfont *font) {
+	SSD1306_SELECT();
 	setFontOnly(font);
+#ifndef TINY4KOLED_NO_UNICODE
 	decodeFn = &SSD1306Device::decodeAsciiInternal;
+#endif
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
 	renderFn = &SSD1306Device::renderOriginalSize;
-	doubleSize = 0;
+	fontScale = 1;
+#endif
 }
 
-void SSD1306Device::setUnicodeFont(const DCUnicodeFont *unicode_font) {
-	oledUnicodeFont = unicode_font;
-	unicodeFontNum = 0;
-	setFontOnly(oledUnicodeFont->fonts[unicodeFontNum].font);
-	decodeFn = &SSD1306Device::decodeUtf8Internal;
-	renderFn = &SSD1306Device::renderOriginalSize;
-	doubleSize = 0;
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+void SSD1306Device::setFontX2(const DCfont *font) {
+	SSD1306_SELECT();
+	setFontOnly(font);
+#ifndef TINY4KOLED_NO_UNICODE
+	decodeFn = &SSD1306Device::decodeAsciiInternal;
+#endif
+	renderFn = &SSD1306Device::renderScaled;
+	fontScale = 2;
 }
 
-void SSD1306Device::setFontX2(const DCfont *font) {
+void SSD1306Device::setFontX2Smooth(const DCfont *font) {
+	SSD1306_SELECT();
 	setFontOnly(font);
+#ifndef TINY4KOLED_NO_UNICODE
 	decodeFn = &SSD1306Device::decodeAsciiInternal;
-	renderFn = &SSD1306Device::renderDoubleSize;
-	doubleSize = 1;
+#endif
+	renderFn = &SSD1306Device::renderDoubleSizeSmooth;
+	fontScale = 2;
 }
 
-void SSD1306Device::setUnicodeFontX2(const DCUnicodeFont *unicode_font) {
-	oledUnicodeFont = unicode_font;
-	unicodeFontNum = 0;
+void SSD1306Device::setFontScaled(const DCfont *font, uint8_t scale) {
+	SSD1306_SELECT();
+	setFont(font);
+	setFontScale(scale);
+}
+
+void SSD1306Device::setFontScale(uint8_t scale) {
+	SSD1306_SELECT();
+	if (scale < 2) {
+		renderFn = &SSD1306Device::renderOriginalSize;
+		fontScale = 1;
+	}
+	else {
+		renderFn = &SSD1306Device::renderScaled;
+		fontScale = scale > 4 ? 4 : scale;
+	}
+}
+#endif
+
+#ifndef TINY4KOLED_NO_UNICODE
+void SSD1306Device::setUnicodeFont(const DCUnicodeFont *unicode_font) {
+	SSD1306_SELECT();
+	ssd1306_set_unicode_font(unicode_font);
 	setFontOnly(oledUnicodeFont->fonts[unicodeFontNum].font);
 	decodeFn = &SSD1306Device::decodeUtf8Internal;
-	renderFn = &SSD1306Device::renderDoubleSize;
-	doubleSize = 1;
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	renderFn = &SSD1306Device::renderOriginalSize;
+	fontScale = 1;
+#endif
 }
 
-void SSD1306Device::setFontX2Smooth(const DCfont *font) {
-	setFontOnly(font);
-	decodeFn = &SSD1306Device::decodeAsciiInternal;
-	renderFn = &SSD1306Device::renderDoubleSizeSmooth;
-	doubleSize = 1;
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+void SSD1306Device::setUnicodeFontX2(const DCUnicodeFont *unicode_font) {
+	SSD1306_SELECT();
+	ssd1306_set_unicode_font(unicode_font);
+	setFontOnly(oledUnicodeFont->fonts[unicodeFontNum].font);
+	decodeFn = &SSD1306Device::decodeUtf8Internal;
+	renderFn = &SSD1306Device::renderScaled;
+	fontScale = 2;
 }
 
 void SSD1306Device::setUnicodeFontX2Smooth(const DCUnicodeFont *unicode_font) {
-	oledUnicodeFont = unicode_font;
-	unicodeFontNum = 0;
+	SSD1306_SELECT();
+	ssd1306_set_unicode_font(unicode_font);
 	setFontOnly(oledUnicodeFont->fonts[unicodeFontNum].font);
 	decodeFn = &SSD1306Device::decodeUtf8Internal;
 	renderFn = &SSD1306Device::renderDoubleSizeSmooth;
-	doubleSize = 1;
+	fontScale = 2;
+}
+
+void SSD1306Device::setUnicodeFontScaled(const DCUnicodeFont *unicode_font, uint8_t scale) {
+	SSD1306_SELECT();
+	setUnicodeFont(unicode_font);
+	setFontScale(scale);
 }
+#endif
+#endif
 
 void SSD1306Device::setFontOnly(const DCfont *font) {
+	SSD1306_SELECT();
 	oledFont = font;
 	if (font->width == 0)
 		characterSpacing = font->spacing;
@@ -249,22 +1001,27 @@ void SSD1306Device::setFontOnly(const DCfont *font) {
 }
 
 void SSD1306Device::setSpacing(uint8_t spacing) {
+	SSD1306_SELECT();
 	characterSpacing = spacing;
 }
 
 void SSD1306Device::setCombineFunction(uint8_t (*combineFunc)(uint8_t, uint8_t, uint8_t)) {
+	SSD1306_SELECT();
 	combineFn = combineFunc;
 }
 
 uint16_t SSD1306Device::getCharacterDataOffset(uint8_t c) {
+	SSD1306_SELECT();
 	uint16_t c_index = (uint16_t)c - oledFont->first;
-	if (c_index == 0) return 0;
+	if (c_index == 0 || oledFont->compression) return 0; // compressed glyphs are found by ssd1306_glyph_start
 
 	uint8_t w = oledFont->width;
 	uint8_t h = oledFont->height;
 
 	if (w > 0) return c_index * w * h;
 
+	if (oledFont->offsets) return pgm_read_word(&(oledFont->offsets[c_index]));
+
 	uint16_t offset = 0;
 	uint16_t c_index16s = c_index >> 4;
 	for (uint16_t pre_c = 0; pre_c < c_index16s; pre_c++)
@@ -281,6 +1038,7 @@ uint16_t SSD1306Device::getCharacterDataOffset(uint8_t c) {
 }
 
 uint8_t SSD1306Device::getCharacterWidth(uint8_t c) {
+	SSD1306_SELECT();
 	uint8_t w = oledFont->width;
 	if (w == 0) {
 		uint16_t c_index = (uint16_t)c - oledFont->first;
@@ -290,6 +1048,7 @@ uint8_t SSD1306Device::getCharacterWidth(uint8_t c) {
 }
 
 uint16_t SSD1306Device::getTextWidth(DATACUTE_F_MACRO_T *text) {
+	SSD1306_SELECT();
 	PGM_P p = reinterpret_cast<PGM_P>(text);
 	uint16_t totalWidth = 0;
 
@@ -304,47 +1063,110 @@ uint16_t SSD1306Device::getTextWidth(DATACUTE_F_MACRO_T *text) {
 }
 
 void SSD1306Device::setCursor(uint8_t x, uint8_t y) {
-	ssd1306_send_command3(renderingFrame | ((y + oledOffsetY) & 0x07), 0x10 | (((x + oledOffsetX) & 0xf0) >> 4), (x + oledOffsetX) & 0x0f);
-	oledX = x;
-	oledY = y;
-	writesSinceSetCursor = 0;
+	SSD1306_SELECT();
+	ssd1306_move_cursor(x, y);
 }
 
 uint8_t SSD1306Device::getCursorX() {
+	SSD1306_SELECT();
 	return oledX;
 }
 
 uint8_t SSD1306Device::getCursorY() {
+	SSD1306_SELECT();
 	return oledY;
 }
 
 void SSD1306Device::clear(void) {
+	SSD1306_SELECT();
 	fill(0x00);
 }
 
 void SSD1306Device::fill(uint8_t fill) {
-	for (uint8_t m = 0; m < oledPages; m++) {
-		setCursor(0, m);
-		fillToEOP(fill);
+	SSD1306_SELECT();
+	// A page window can't run past page 7, which the pages of the second frame of a screen taller than 32 pixels would.
+	if (combineFn || (((renderingFrame | (oledOffsetY & 0x07)) & 0x07) + oledPages > 8)) {
+		for (uint8_t m = 0; m < oledPages; m++) {
+			setCursor(0, m);
+			fillToEOP(fill);
+		}
+		setCursor(0, 0);
+		return;
 	}
-	setCursor(0, 0);
+
+	// Fill the whole screen as one run, using a horizontal addressing window
+	uint8_t top = (renderingFrame | (oledOffsetY & 0x07)) & 0x07;
+	ssd1306_send_command_start();
+	ssd1306_send_byte(0x20);
+	ssd1306_send_byte(0x00);
+	ssd1306_send_byte(0x21);
+	ssd1306_send_byte(oledOffsetX);
+	ssd1306_send_byte(oledOffsetX + oledWidth - 1);
+	ssd1306_send_byte(0x22);
+	ssd1306_send_byte(top);
+	ssd1306_send_byte(top + oledPages - 1);
+	ssd1306_send_stop();
+
+	ssd1306_send_data_start();
+	ssd1306_send_data_repeat(fill, oledWidth * oledPages);
+	ssd1306_send_stop();
+
+	ssd1306_send_command_start();
+	ssd1306_send_byte(0x21);
+	ssd1306_send_byte(0x00);
+	ssd1306_send_byte(0x7F);
+	ssd1306_send_window_close();
+	ssd1306_send_stop();
+	pointerAtCursor = false;
+	ssd1306_move_cursor(0, 0);
 }
 
 void SSD1306Device::newLine(uint8_t fontHeight) {
-	uint8_t h = fontHeight << doubleSize;
-	oledY+=h;
-	if (oledY > oledPages - h) {
-		oledY = oledPages - h;
+	uint8_t h = fontHeight * fontScale;
+	uint8_t y = oledY + h;
+	if (y > oledPages - h) {
+		if (consoleMode) scrollConsole(y + h - oledPages);
+		y = oledPages - h;
 	}
-	setCursor(0, oledY);
+	setCursor(0, y);
+}
+
+void SSD1306Device::setConsoleMode(bool enable) {
+	SSD1306_SELECT();
+	if (!enable && consoleScroll) {
+#ifndef TINY4KOLED_WIDTH
+		oledOffsetY = (oledOffsetY - consoleScroll) & 0x07;
+#endif
+		consoleScroll = 0;
+		ssd1306_cursor_relocated();
+		ssd1306_send_command(drawingFrame);
+	}
+	consoleMode = enable;
+}
+
+// Clears the pages that will scroll into view at the bottom, then moves the display's start line down to show them.
+void SSD1306Device::scrollConsole(uint8_t pages) {
+	if (pages > 8) pages = 8;
+#ifndef TINY4KOLED_WIDTH
+	oledOffsetY = (oledOffsetY + pages) & 0x07;
+#endif
+	consoleScroll = (consoleScroll + pages) & 0x07;
+	pointerAtCursor = false;
+	for (uint8_t page = oledPages - pages; page < oledPages; page++) {
+		ssd1306_move_cursor(0, page);
+		fillLength(0x00, oledWidth);
+	}
+	ssd1306_send_command(0x40 | ((drawingFrame + (consoleScroll << 3)) & 0x3F));
 }
 
 void SSD1306Device::newLine(void) {
+	SSD1306_SELECT();
 	newLine(oledFont->height);
 }
 
 size_t SSD1306Device::write(byte c) {
-	if (decodeFn) (this->*decodeFn)(c);
+	SSD1306_SELECT();
+	SSD1306_DECODE(c);
 	return 1;
 }
 
@@ -359,7 +1181,7 @@ void SSD1306Device::decodeAsciiInternal(uint8_t c) {
 
 	if (oledFont->first <= c &&
 	    oledFont->last >= c)
-  	(this->*renderFn)(c);
+  	SSD1306_RENDER(c);
 }
 
 void SSD1306Device::renderOriginalSize(uint8_t c) {
@@ -375,72 +1197,92 @@ void SSD1306Device::renderOriginalSize(uint8_t c) {
 		spacing = 0;
 	}
 
-	uint16_t offset = getCharacterDataOffset(c);
-	uint8_t line = h;
-	do
-	{
-		ssd1306_send_data_start();
-		for (uint8_t i = 0; i < w; i++) {
-			ssd1306_send_data_byte(pgm_read_byte(&(oledFont->bitmap[offset++])));
-		}
-		repeatData(0, spacing);
-		ssd1306_send_stop();
-		if (line > 1) {
-			setCursor(oledX, oledY + 1);
-		}
-		else {
-			setCursor(oledX + w + spacing, oledY - (h - 1));
-		}
+	ssd1306_send_window_start(h);
+	sendCharacterColumns(c, 0, w);
+	ssd1306_send_window_columns(0, 0, spacing, h);
+	ssd1306_send_stop();
+}
+
+// Sends columns of a character into the open window, after skipping its first skip columns.
+void SSD1306Device::sendCharacterColumns(uint8_t c, uint8_t skip, uint8_t columns) {
+	uint8_t h = oledFont->height;
+	if (oledFont->compression) {
+		ssd1306_glyph_start(c);
+		for (uint16_t i = skip * h; i > 0; i--) ssd1306_glyph_byte();
+		ssd1306_send_glyph_columns(columns, h);
+		return;
 	}
-	while (--line);
+	uint16_t offset = getCharacterDataOffset(c);
+	ssd1306_send_window_columns(&(oledFont->bitmap[offset + skip]), getCharacterWidth(c), columns, h);
 }
 
 uint8_t SSD1306Device::getExpectedUtf8Bytes(void) {
+	SSD1306_SELECT();
 	return utf8Continuation;
 }
 
 void SSD1306Device::RenderUnicodeSpace(void) {
-	uint8_t spaceWidth = (oledUnicodeFont->space_width + characterSpacing) << doubleSize;
+	uint8_t spaceWidth = (oledUnicodeFont->space_width + characterSpacing) * fontScale;
 	if (oledX > ((uint8_t)oledWidth - spaceWidth)) {
 		newLine(oledFont->height);
 	} else {
-		uint8_t textHeight = oledFont->height << doubleSize;
-		uint8_t line = textHeight;
-		do
-		{
-			ssd1306_send_data_start();
-			repeatData(0, spaceWidth);
-			ssd1306_send_stop();
-			if (line > 1) {
-				setCursor(oledX, oledY + 1);
-			}
-			else {
-				setCursor(oledX + spaceWidth, oledY - (textHeight - 1));
-			}
-		}
-		while (--line);
+		uint8_t textHeight = oledFont->height * fontScale;
+		ssd1306_send_window_start(textHeight);
+		ssd1306_send_window_columns(0, 0, spaceWidth, textHeight);
+		ssd1306_send_stop();
+	}
+}
+
+static bool ssd1306_unicode_font_covers(uint8_t fontNum) {
+	const DCUnicodeFontRef *ref = &oledUnicodeFont->fonts[fontNum];
+	return ref->unicode_block == unicodeCodepoint.unicode.block &&
+	       ref->unicode_plane == unicodeCodepoint.unicode.plane &&
+	       ref->font->first <= unicodeCodepoint.unicode.offset &&
+	       ref->font->last >= unicodeCodepoint.unicode.offset;
+}
+
+// Binary searches the unicode font's index for the last range starting at or before the codepoint.
+static uint8_t ssd1306_unicode_index_search(void) {
+	const DCUnicodeFontIndex *index = oledUnicodeFont->index;
+	uint32_t codepoint = unicodeCodepoint.codepoint;
+	uint8_t low = 0, high = oledUnicodeFont->num_fonts;
+	while (low < high) {
+		uint8_t mid = (low + high) >> 1;
+		uint32_t start = ((uint32_t)pgm_read_byte(&index[mid].unicode_plane) << 16) |
+		                 ((uint16_t)pgm_read_byte(&index[mid].unicode_block) << 8) |
+		                 pgm_read_byte(&index[mid].first);
+		if (start <= codepoint) low = mid + 1;
+		else high = mid;
 	}
+	if (low == 0) return NO_UNICODE_FONT;
+	const DCUnicodeFontIndex *entry = &index[low - 1];
+	if (pgm_read_byte(&entry->unicode_plane) != unicodeCodepoint.unicode.plane ||
+	    pgm_read_byte(&entry->unicode_block) != unicodeCodepoint.unicode.block ||
+	    pgm_read_byte(&entry->last) < unicodeCodepoint.unicode.offset) return NO_UNICODE_FONT;
+	return pgm_read_byte(&entry->font);
 }
 
 bool SSD1306Device::SelectUnicodeBlock(void) {
-	if (oledUnicodeFont->fonts[unicodeFontNum].unicode_block == unicodeCodepoint.unicode.block && 
-	    oledUnicodeFont->fonts[unicodeFontNum].unicode_plane == unicodeCodepoint.unicode.plane &&
-	    oledUnicodeFont->fonts[unicodeFontNum].font->first <= unicodeCodepoint.unicode.offset &&
-	    oledUnicodeFont->fonts[unicodeFontNum].font->last >= unicodeCodepoint.unicode.offset) return true;
-	uint8_t fontNum = unicodeFontNum + 1;
-	if (fontNum == oledUnicodeFont->num_fonts) fontNum = 0;
-	while(fontNum != unicodeFontNum) {
-		if (oledUnicodeFont->fonts[fontNum].unicode_block == unicodeCodepoint.unicode.block && 
-		    oledUnicodeFont->fonts[fontNum].unicode_plane == unicodeCodepoint.unicode.plane &&
-		    oledUnicodeFont->fonts[fontNum].font->first <= unicodeCodepoint.unicode.offset &&
-		    oledUnicodeFont->fonts[fontNum].font->last >= unicodeCodepoint.unicode.offset) {
-			unicodeFontNum = fontNum;
-			setFontOnly(oledUnicodeFont->fonts[unicodeFontNum].font);
-			return true;
-		}
-		if (fontNum++ == oledUnicodeFont->num_fonts) fontNum = 0;
+	if (ssd1306_unicode_font_covers(unicodeFontNum)) return true;
+	uint8_t fontNum = NO_UNICODE_FONT;
+	if (unicodeCodepoint.codepoint < 0x80 && asciiFontNum != NO_UNICODE_FONT && ssd1306_unicode_font_covers(asciiFontNum)) {
+		fontNum = asciiFontNum;
 	}
-	return false;
+	else if (oledUnicodeFont->index) {
+		fontNum = ssd1306_unicode_index_search();
+	}
+	else {
+		for (uint8_t n = 0; n < oledUnicodeFont->num_fonts; n++) {
+			if (n != unicodeFontNum && ssd1306_unicode_font_covers(n)) {
+				fontNum = n;
+				break;
+			}
+		}
+	}
+	if (fontNum == NO_UNICODE_FONT) return false;
+	unicodeFontNum = fontNum;
+	setFontOnly(oledUnicodeFont->fonts[unicodeFontNum].font);
+	return true;
 }
 
 void SSD1306Device::decodeUtf8Internal(uint8_t utf8byte) {
@@ -485,11 +1327,35 @@ void SSD1306Device::decodeUtf8Internal(uint8_t utf8byte) {
 
 	// If none of the fonts support the current unicode block, don't output anything.
 	if (SelectUnicodeBlock()) {
-		(this->*renderFn)(unicodeCodepoint.unicode.offset);
+		SSD1306_RENDER(unicodeCodepoint.unicode.offset);
 	}
 }
 
+// Each nibble spread into 4 * scale bits, for scales of 2, 3 and 4.
+static const uint16_t ssd1306_scale_nibbles[3][16] PROGMEM = {
+	{ 0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F,
+	  0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF },
+	{ 0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF,
+	  0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF },
+	{ 0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+	  0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF }
+};
+
+// Spreads the 8 bits of a byte into 8 * scale bits, each bit repeated scale times.
+static uint32_t ssd1306_scale_bits(uint8_t bits, uint8_t scale) {
+	const uint16_t *nibbles = ssd1306_scale_nibbles[scale - 2];
+	uint32_t low = pgm_read_word(&nibbles[bits & 0x0F]);
+	uint32_t high = pgm_read_word(&nibbles[bits >> 4]);
+	return low | (high << (scale << 2));
+}
+
 static uint16_t ReadCharacterBits(uint8_t * cPtr, uint8_t w) {
+  if (oledFont->compression) {
+    // compressed glyphs are read in column order
+    uint16_t resultBits = ssd1306_glyph_byte();
+    if (oledFont->height > 1) resultBits |= (uint16_t)ssd1306_glyph_byte() << 8;
+    return resultBits;
+  }
   uint16_t resultBits = pgm_read_byte(cPtr);
   if (oledFont->height > 1) {
     // change type before shifting, as otherwise signed ints will be used.
@@ -499,60 +1365,104 @@ static uint16_t ReadCharacterBits(uint8_t * cPtr, uint8_t w) {
 }
 
 static uint32_t Stretch(uint16_t x) {
-  uint32_t x32 = (uint32_t)x;
-  x32 = (x32<<8 | x32) & 0x00FF00FF;
-  x32 = (x32<<4 | x32) & 0x0F0F0F0F;        // 0000abcd____efgh -> 0000abcd0000efgh
-  x32 = (x32<<2 | x32) & 0x33333333;        // 00ab__cd00ef__gh -> 00ab00cd00ef00gh
-  x32 = (x32<<1 | x32) & 0x55555555;        // 0a_b0c_d0e_f0g_h -> 0a0b0c0d0e0f0g0h
-  return x32 | x32<<1;                      // aabbccddeeffgghh
+  return ssd1306_scale_bits(x, 2) | (ssd1306_scale_bits(x >> 8, 2) << 16); // aabbccddeeffgghh
+}
+
+// Smooths the diagonals between two adjacent columns of a character, in the style of Scale2x.
+// Where a pixel and its diagonal neighbour are not joined by either of the other two pixels of their 2x2 square,
+// the doubled pixels are widened into the gap on both sides, for all rows at once.
+static void SmoothColumns(uint16_t col0, uint16_t col1, uint32_t *col0R, uint32_t *col1L) {
+  uint16_t rising = ~col0 & (col0 >> 1) & col1 & ~(col1 >> 1);  // col0 row i+1 and col1 row i
+  uint16_t falling = col0 & ~(col0 >> 1) & ~col1 & (col1 >> 1); // col0 row i and col1 row i+1
+  uint32_t r = Stretch(rising);
+  uint32_t f = Stretch(falling);
+  *col0R |= (r & 0xAAAAAAAA) | ((f & 0x55555555) << 2);
+  *col1L |= (f & 0xAAAAAAAA) | ((r & 0x55555555) << 2);
 }
 
 void SSD1306Device::sendDoubleBits(uint32_t doubleBits) {
-  ssd1306_send_data_byte(doubleBits);
-  ssd1306_send_data_byte(doubleBits>>8);
+  ssd1306_send_window_byte(doubleBits, 0);
+  ssd1306_send_window_byte(doubleBits>>8, 1);
   if (oledFont->height > 1) {
-    ssd1306_send_data_byte(doubleBits>>16);
-    ssd1306_send_data_byte(doubleBits>>24);
+    ssd1306_send_window_byte(doubleBits>>16, 2);
+    ssd1306_send_window_byte(doubleBits>>24, 3);
   }
+  oledX++;
 }
 
-void SSD1306Device::renderDoubleSize(uint8_t c) {
-	uint16_t offset = getCharacterDataOffset(c);
+// Draws the character fontScale times larger, one scaled column at a time, into a window of height * fontScale pages.
+void SSD1306Device::renderScaled(uint8_t c) {
+	uint8_t scale = fontScale;
 	uint8_t w = getCharacterWidth(c);
 	uint8_t h = oledFont->height;
+	uint8_t pages = h * scale;
+	uint8_t spacing = characterSpacing;
+	uint8_t column[8];
+
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+	// A character that would be taller than the display is drawn at the largest scale that fits.
+	if (pages > oledPages && scale > 1) {
+		uint8_t requested = fontScale;
+		fontScale = oledPages / h;
+		if (fontScale > 1) renderScaled(c);
+		else {
+			fontScale = 1;
+			renderOriginalSize(c);
+		}
+		fontScale = requested;
+		return;
+	}
+#endif
 
-	// change memory mode to advance pages, before columns
-	setMemoryAddressingMode(1);
-	uint8_t topPage = oledY + (renderingFrame & 0x04);
-	setPageAddress(topPage, topPage + h + h - 1);
-
-	ssd1306_send_data_start();
-	uint8_t * cPtr = &(oledFont->bitmap[offset]);
-	for (uint8_t col = 0 ; col < w; col++) {
-		uint16_t col0 = ReadCharacterBits(cPtr + col, w);
-		uint32_t col0L = Stretch(col0);
-		sendDoubleBits(col0L);
-		sendDoubleBits(col0L);
+	if (oledX > ((uint8_t)oledWidth - w * scale)) {
+		newLine(h);
 	}
-	ssd1306_send_stop();
 
-	setMemoryAddressingMode(2);
-	setPageAddress(0,7);
+	if (oledX + (w + spacing) * scale > (uint8_t)oledWidth) {
+		spacing = 0;
+	}
 
-	setCursor(oledX + (w + characterSpacing) * 2 , oledY);
+	const uint8_t *cPtr = &(oledFont->bitmap[getCharacterDataOffset(c)]);
+	if (oledFont->compression) ssd1306_glyph_start(c);
+	ssd1306_send_window_start(pages);
+	for (uint8_t col = 0; col < w; col++) {
+		uint8_t *out = column;
+		const uint8_t *p = cPtr + col;
+		for (uint8_t page = 0; page < h; page++) {
+			uint32_t bits = ssd1306_scale_bits(oledFont->compression ? ssd1306_glyph_byte() : pgm_read_byte(p), scale);
+			for (uint8_t i = 0; i < scale; i++) {
+				*out++ = bits;
+				bits >>= 8;
+			}
+			p += w;
+		}
+		for (uint8_t i = 0; i < scale; i++) {
+			for (uint8_t page = 0; page < pages; page++) {
+				ssd1306_send_window_byte(column[page], page);
+			}
+			oledX++;
+		}
+	}
+	ssd1306_send_window_columns(0, 0, spacing * scale, pages);
+	ssd1306_send_stop();
 }
 
 void SSD1306Device::renderDoubleSizeSmooth(uint8_t c) {
 	uint16_t offset = getCharacterDataOffset(c);
+	if (oledFont->compression) ssd1306_glyph_start(c);
 	uint8_t w = getCharacterWidth(c);
 	uint8_t h = oledFont->height;
+	uint8_t spacing = characterSpacing;
 
-	// change memory mode to advance pages, before columns
-	setMemoryAddressingMode(1);
-	uint8_t topPage = oledY + (renderingFrame & 0x04);
-	setPageAddress(topPage, topPage + h + h - 1);
+	if (oledX > ((uint8_t)oledWidth - w * 2)) {
+		newLine(h);
+	}
 
-	ssd1306_send_data_start();
+	if (oledX + (w + spacing) * 2 > (uint8_t)oledWidth) {
+		spacing = 0;
+	}
+
+	ssd1306_send_window_start(h + h);
 
 	uint8_t * cPtr = &(oledFont->bitmap[offset]);
 	uint16_t col0 = ReadCharacterBits(cPtr, w);
@@ -563,46 +1473,119 @@ void SSD1306Device::renderDoubleSizeSmooth(uint8_t c) {
 		uint16_t col1 = ReadCharacterBits(cPtr + col, w);
 		col1L = Stretch(col1);
 		col1R = col1L;
-		for (uint8_t i=0; i<16; i++) { // (15 pairs of bits in 8 bit line)
-			for (uint8_t j=1; j<3; j++) {
-				if (((col0>>i & 0b11) == (uint8_t)(3-j)) && ((col1>>i & 0b11) == j)) {
-					col0R |= (uint32_t)1<<((i*2)+j);
-					col1L |= (uint32_t)1<<((i*2)+3-j);
-				}
-			}
-		}
+		SmoothColumns(col0, col1, &col0R, &col1L);
 		sendDoubleBits(col0L);
 		sendDoubleBits(col0R);
 		col0L = col1L; col0R = col1R; col0 = col1;
 	}
 	sendDoubleBits(col0L);
 	sendDoubleBits(col0R);
+	ssd1306_send_window_columns(0, 0, spacing * 2, h + h);
 	ssd1306_send_stop();
-	setMemoryAddressingMode(2);
-	setPageAddress(0,7);
-	setCursor(oledX + (w + characterSpacing) * 2 , oledY);
 }
 
 void SSD1306Device::bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t bitmap[]) {
+	SSD1306_SELECT();
 	uint16_t j = 0;
  	for (uint8_t y = y0; y < y1; y++) {
-		setCursor(x0,y);
-		ssd1306_send_data_start();
-		for (uint8_t x = x0; x < x1; x++) {
-			ssd1306_send_data_byte(pgm_read_byte(&bitmap[j++]));
+		ssd1306_move_cursor(x0, y);
+		ssd1306_send_cursor_data_start();
+		if (combineFn) {
+			for (uint8_t x = x0; x < x1; x++) {
+				ssd1306_send_data_byte(pgm_read_byte(&bitmap[j++]));
+			}
+		}
+		else {
+			ssd1306_send_block(&bitmap[j], x1 - x0, true);
+			j += x1 - x0;
 		}
 		ssd1306_send_stop();
+		pointerAtCursor = false;
 	}
 	setCursor(0, 0);
 }
 
+// Skipping a run of zeros ends the data transaction, and sends one or two windows, so is only worth it for longer runs.
+#define BITMAP_SKIP_ZEROS 24
+
+void SSD1306Device::bitmapCompressed(uint8_t x0, uint8_t y0, const uint8_t bitmap[], bool transparent) {
+	SSD1306_SELECT();
+	uint8_t width = pgm_read_byte(&bitmap[0]);
+	uint8_t x1 = x0 + width;
+	uint8_t y1 = y0 + pgm_read_byte(&bitmap[1]);
+	uint8_t x = x0, y = y0;
+	bool open = false; // whether a window and data transaction are open
+	bool rowOnly = false; // whether the window ends with the current row, as it did not start at x0
+	bool modeSet = false;
+	ssd1306_bitmap_start(&bitmap[2]);
+	while (y < y1) {
+		ssd1306_bitmap_token();
+		if (transparent && !combineFn) {
+			uint16_t zeros = ssd1306_bitmap_zeros();
+			if (zeros >= BITMAP_SKIP_ZEROS) {
+				ssd1306_bitmap_skip(zeros);
+				if (open) ssd1306_send_stop();
+				open = false;
+				uint16_t position = (uint16_t)(x - x0) + zeros;
+				y += position / width;
+				x = x0 + position % width;
+				continue;
+			}
+		}
+		if (!open) {
+			rowOnly = x != x0;
+			uint8_t top = (renderingFrame | ((y + oledOffsetY) & 0x07)) & 0x07;
+			uint8_t bottom = rowOnly ? top : (renderingFrame | ((y1 - 1 + oledOffsetY) & 0x07)) & 0x07;
+			ssd1306_send_command_start();
+			if (!modeSet) {
+				ssd1306_send_byte(0x20);
+				ssd1306_send_byte(0x00);
+				modeSet = true;
+			}
+			ssd1306_send_byte(0x21);
+			ssd1306_send_byte(x + oledOffsetX);
+			ssd1306_send_byte(x1 - 1 + oledOffsetX);
+			ssd1306_send_byte(0x22);
+			ssd1306_send_byte(top);
+			ssd1306_send_byte(bottom);
+			ssd1306_send_stop();
+			ssd1306_send_data_start();
+			open = true;
+		}
+		uint8_t byte = ssd1306_bitmap_byte();
+		if (combineFn) byte = (*combineFn)(x, y, byte);
+		ssd1306_send_byte(byte);
+		if (++x == x1) {
+			x = x0;
+			y++;
+			if (rowOnly) {
+				ssd1306_send_stop();
+				open = false;
+			}
+		}
+	}
+	if (open) ssd1306_send_stop();
+	if (modeSet) {
+		ssd1306_send_command_start();
+		ssd1306_send_byte(0x21);
+		ssd1306_send_byte(0x00);
+		ssd1306_send_byte(0x7F);
+		ssd1306_send_window_close();
+		ssd1306_send_stop();
+	}
+	pointerAtCursor = false;
+	ssd1306_move_cursor(0, 0);
+}
+
 void SSD1306Device::clearToEOL(void) {
+	SSD1306_SELECT();
 	fillToEOL(0x00);
 }
 
 void SSD1306Device::fillToEOL(uint8_t fill) {
+	SSD1306_SELECT();
 	uint8_t x = oledX;
-	uint8_t pagesToClear = oledFont->height << doubleSize;
+	uint8_t pagesToClear = oledFont->height * fontScale;
 	do
 	{
 		fillToEOP(fill);
@@ -614,48 +1597,289 @@ void SSD1306Device::fillToEOL(uint8_t fill) {
 }
 
 void SSD1306Device::clearToEOP(void) {
+	SSD1306_SELECT();
 	fillToEOP(0x00);
 }
 
 void SSD1306Device::fillToEOP(uint8_t fill) {
+	SSD1306_SELECT();
 	fillLength(fill, oledWidth - oledX);
 }
 
 void SSD1306Device::fillLength(uint8_t fill, uint8_t length) {
+	SSD1306_SELECT();
 	if (length == 0) return;
+	ssd1306_send_cursor_data_start();
 	oledX += length;
-	ssd1306_send_data_start();
 	repeatData(fill, length);
 	ssd1306_send_stop();
 }
 
 void SSD1306Device::startData(void) {
-	ssd1306_send_data_start();
+	SSD1306_SELECT();
+	ssd1306_send_cursor_data_start();
+	pointerAtCursor = false;
 }
 
 void SSD1306Device::sendData(const uint8_t data) {
+	SSD1306_SELECT();
 	ssd1306_send_data_byte(data);
 }
 
 void SSD1306Device::repeatData(uint8_t data, uint8_t length) {
-	for (uint8_t x = 0; x < length; x++) {
-		ssd1306_send_data_byte(data);
+	SSD1306_SELECT();
+	if (combineFn) {
+		for (uint8_t x = 0; x < length; x++) {
+			ssd1306_send_data_byte(data);
+		}
+		return;
 	}
+	ssd1306_send_data_repeat(data, length);
+	writesSinceSetCursor += length;
 }
 
 void SSD1306Device::clearData(uint8_t length) {
+	SSD1306_SELECT();
 	repeatData(0, length);
 }
 
 void SSD1306Device::endData(void) {
+	SSD1306_SELECT();
 	ssd1306_send_stop();
 }
 
 void SSD1306Device::invertOutput(bool enable) {
+	SSD1306_SELECT();
 	combineFn = enable ? &invertByte : NULL;
-}	
+}
+
+void SSD1306Device::setFrameBuffer(DCFrameBuffer *buffer) {
+	SSD1306_SELECT();
+	if (frameBuffer) {
+		// The display was left in page addressing mode by the last flush, or not changed since the buffer was attached.
+		ssd1306_swap_transport();
+		windowPages = 0;
+		pointerAtCursor = false;
+		cursorPending = true;
+	}
+	else {
+		ssd1306_send_pending_cursor();
+	}
+	frameBuffer = buffer;
+	if (!buffer) return;
+
+	buffer->firstColumn = 0;
+	buffer->columns = SSD1306_COLUMNS;
+	buffer->composite = false;
+	ssd1306_start_capture();
+	// The buffer's contents are not known to match the display.
+	ssd1306_frame_buffer_dirty(0, SSD1306_COLUMNS - 1);
+}
+
+// For each tile of tileWidth columns of one page, the tile is cleared, drawFunc is called with the tile's position,
+// and the tile is sent to the display in one data transaction.
+// Within drawFunc the drawing methods are ORed into the tile, and drawFunc may also set bits in the tile directly.
+void SSD1306Device::drawTiles(uint8_t *tile, uint8_t tileWidth, void (*drawFunc)(uint8_t x, uint8_t page, uint8_t *tile)) {
+	SSD1306_SELECT();
+	if (frameBuffer || tileWidth == 0) return;
+	ssd1306_send_pending_cursor();
+	DCFrameBuffer fb = {};
+	fb.buffer = tile;
+	fb.pages = 1;
+	fb.composite = true;
+	for (uint8_t page = 0; page < oledPages; page++) {
+		for (uint8_t x = 0; x < oledWidth; x += tileWidth) {
+			uint8_t columns = oledWidth - x;
+			if (columns > tileWidth) columns = tileWidth;
+			fb.firstPage = (renderingFrame | ((page + oledOffsetY) & 0x07)) & 0x07;
+			fb.firstColumn = x + oledOffsetX;
+			fb.columns = columns;
+			memset(tile, 0, columns);
+
+			frameBuffer = &fb;
+			ssd1306_start_capture();
+			drawFunc(x, page, tile);
+			ssd1306_swap_transport();
+			frameBuffer = 0;
+			windowPages = 0;
+			pointerAtCursor = false;
+
+			ssd1306_move_cursor(x, page);
+			ssd1306_send_cursor_data_start();
+			ssd1306_send_block(tile, columns, false);
+			ssd1306_send_stop();
+		}
+	}
+	pointerAtCursor = false;
+	cursorPending = true;
+}
+
+// Sends the next run of changed pages in one window. Returns false when no pages had changes.
+static bool ssd1306_flush_pages(DCFrameBuffer *fb, bool windowed) {
+	uint8_t row = 0;
+	while (row < fb->pages && fb->dirtyStart[row] > fb->dirtyEnd[row]) row++;
+	if (row == fb->pages) return false;
+	uint8_t start = fb->dirtyStart[row];
+	uint8_t end = fb->dirtyEnd[row];
+	uint8_t last = row;
+	uint16_t cost = end - start + 1;
+	while (last + 1 < fb->pages && fb->dirtyStart[last + 1] <= fb->dirtyEnd[last + 1]) {
+		uint8_t nextStart = fb->dirtyStart[last + 1];
+		uint8_t nextEnd = fb->dirtyEnd[last + 1];
+		uint8_t unionStart = nextStart < start ? nextStart : start;
+		uint8_t unionEnd = nextEnd > end ? nextEnd : end;
+		uint16_t combined = (uint16_t)(unionEnd - unionStart + 1) * (last - row + 2);
+		if (combined > cost + (nextEnd - nextStart + 1) + 10) break;
+		cost = combined;
+		start = unionStart;
+		end = unionEnd;
+		last++;
+	}
+
+	ssd1306_send_command_start();
+	if (!windowed) {
+		ssd1306_send_byte(0x20);
+		ssd1306_send_byte(0x00);
+	}
+	ssd1306_send_byte(0x21);
+	ssd1306_send_byte(start);
+	ssd1306_send_byte(end);
+	ssd1306_send_byte(0x22);
+	ssd1306_send_byte(fb->firstPage + row);
+	ssd1306_send_byte(fb->firstPage + last);
+	ssd1306_send_stop();
+
+	ssd1306_send_data_start();
+	for (; row <= last; row++) {
+		ssd1306_send_block(fb->buffer + row * SSD1306_COLUMNS + start, end - start + 1, false);
+		fb->dirtyStart[row] = 0xFF;
+		fb->dirtyEnd[row] = 0;
+	}
+	ssd1306_send_stop();
+	return true;
+}
+
+// Returns the controller to page addressing mode after flushing.
+static void ssd1306_flush_close(void) {
+	ssd1306_send_command_start();
+	ssd1306_send_byte(0x20);
+	ssd1306_send_byte(0x02);
+	ssd1306_send_byte(0x21);
+	ssd1306_send_byte(0x00);
+	ssd1306_send_byte(0x7F);
+	ssd1306_send_byte(0x22);
+	ssd1306_send_byte(0x00);
+	ssd1306_send_byte(0x07);
+	ssd1306_send_stop();
+}
+
+// Sends the changes to the first changed page of the frame buffer, in a window in horizontal addressing mode.
+// Following pages are sent in the same window while that is cheaper than another window,
+// which costs about ten bytes in two more transactions. This repeats until no changes remain.
+void SSD1306Device::flush(void) {
+	SSD1306_SELECT();
+	DCFrameBuffer *fb = frameBuffer;
+	if (!fb) return;
+	ssd1306_swap_transport();
+	bool windowed = false;
+	while (ssd1306_flush_pages(fb, windowed)) windowed = true;
+	if (windowed) ssd1306_flush_close();
+	ssd1306_swap_transport();
+}
+
+// Flushes only the next run of changed pages, returning true while there are more changes to flush.
+// Calling this in turn for several displays shares the bus between them, rather than one display's flush delaying the others.
+bool SSD1306Device::flushStep(void) {
+	SSD1306_SELECT();
+	DCFrameBuffer *fb = frameBuffer;
+	if (!fb) return false;
+	ssd1306_swap_transport();
+	if (ssd1306_flush_pages(fb, false)) ssd1306_flush_close();
+	ssd1306_swap_transport();
+	for (uint8_t row = 0; row < fb->pages; row++) {
+		if (fb->dirtyStart[row] <= fb->dirtyEnd[row]) return true;
+	}
+	return false;
+}
+
+// Starts a data transaction at a column of one of the controller's pages, in page addressing mode.
+static void ssd1306_send_position_data_start(uint8_t page, uint8_t column) {
+#ifdef TINY4KOLED_MIXED_TRANSACTIONS
+	ssd1306_send_start();
+	ssd1306_send_mixed_command(0xB0 | page);
+	ssd1306_send_mixed_command(0x10 | (column >> 4));
+	ssd1306_send_mixed_command(column & 0x0F);
+	ssd1306_send_mixed_control(SSD1306_DATA);
+#else
+	ssd1306_send_command_start();
+	ssd1306_send_byte(0xB0 | page);
+	ssd1306_send_byte(0x10 | (column >> 4));
+	ssd1306_send_byte(column & 0x0F);
+	ssd1306_send_stop();
+	ssd1306_send_data_start();
+#endif
+}
+
+// The bytes of each slice sent by service, besides its data
+#ifdef TINY4KOLED_MIXED_TRANSACTIONS
+#define SSD1306_SLICE_OVERHEAD 7
+#else
+#define SSD1306_SLICE_OVERHEAD 5
+#endif
+
+// Sends the frame buffer's changes a slice at a time, each slice being part of the changes to one page,
+// until up to budget bytes, including those that address the slices, have been sent.
+// The changes not yet sent remain marked, so the next call resumes where this one stopped.
+// At least one byte is sent by each call. Returns true while there are more changes to send.
+bool SSD1306Device::service(uint16_t budget) {
+	SSD1306_SELECT();
+	DCFrameBuffer *fb = frameBuffer;
+	if (!fb) return false;
+	ssd1306_swap_transport();
+	bool sent = false;
+	for (uint8_t row = 0; row < fb->pages; row++) {
+		while (fb->dirtyStart[row] <= fb->dirtyEnd[row]) {
+			uint8_t start = fb->dirtyStart[row];
+			uint8_t end = fb->dirtyEnd[row];
+			uint16_t room = budget > SSD1306_SLICE_OVERHEAD ? budget - SSD1306_SLICE_OVERHEAD : !sent;
+			if (room == 0) {
+				ssd1306_swap_transport();
+				return true;
+			}
+			uint16_t count = end - start + 1;
+			if (count > room) count = room;
+			ssd1306_send_position_data_start((fb->firstPage + row) & 0x07, start);
+			// Each slice is kept to one transaction, rather than being split by the transport's buffer size.
+			count = ssd1306_send_room(count);
+			ssd1306_send_block(fb->buffer + row * SSD1306_COLUMNS + start, count, false);
+			ssd1306_send_stop();
+			sent = true;
+			budget = budget > count + SSD1306_SLICE_OVERHEAD ? budget - count - SSD1306_SLICE_OVERHEAD : 0;
+			if (start + count > end) {
+				fb->dirtyStart[row] = 0xFF;
+				fb->dirtyEnd[row] = 0;
+			}
+			else {
+				fb->dirtyStart[row] = start + count;
+			}
+		}
+	}
+	ssd1306_swap_transport();
+	return false;
+}
+
+#ifdef TINY4KOLED_STATS
+DCTransferStats SSD1306Device::getStats(void) {
+	return transferStats;
+}
+
+void SSD1306Device::resetStats(void) {
+	transferStats = DCTransferStats();
+}
+#endif
 
 void SSD1306Device::clipText(uint16_t startPixel, uint8_t width, DATACUTE_F_MACRO_T *text) {
+	SSD1306_SELECT();
 	uint8_t h = oledFont->height;
 	uint8_t w = oledFont->width;
 	PGM_P p = reinterpret_cast<PGM_P>(text);
@@ -667,35 +1891,59 @@ void SSD1306Device::clipText(uint16_t startPixel, uint8_t width, DATACUTE_F_MACR
 	uint16_t charactersToSkip = startPixel / w;
 	uint8_t initialSkip = startPixel % w;
 	p += charactersToSkip;
+	ssd1306_send_window_start(h);
 	while (drawnColumns < width) {
 		unsigned char c = pgm_read_byte(p++);
 		if (c == 0) break;
-		uint16_t offset = ((uint16_t)c - oledFont->first) * w * h;
-		uint8_t line = h;
-		do
-		{
-			offset += initialSkip;
-			ssd1306_send_data_start();
-			for (uint8_t i = 0; (i < w - initialSkip) && ((drawnColumns + i) < width); i++) {
-				ssd1306_send_data_byte(pgm_read_byte(&(oledFont->bitmap[offset + i])));
-			}
-			offset += w - initialSkip;
-			ssd1306_send_stop();
-			if (h > 1) {
-				if (line > 1) {
-					setCursor(oledX, oledY + 1);
-				}
-				else {
-					setCursor(oledX + w, oledY - (h - 1));
-				}
-			}
-		} while (--line);
-		drawnColumns += w - initialSkip;
+		uint8_t columns = w - initialSkip;
+		if (columns > width - drawnColumns) {
+			columns = width - drawnColumns;
+		}
+		sendCharacterColumns(c, initialSkip, columns);
+		drawnColumns += columns;
 		initialSkip = 0;
 	}
+	ssd1306_send_stop();
+}
+
+void SSD1306Device::drawString(const char *text, uint8_t width) {
+	SSD1306_SELECT();
+	renderString(text, false, width);
+}
+
+void SSD1306Device::drawString(DATACUTE_F_MACRO_T *text, uint8_t width) {
+	SSD1306_SELECT();
+	renderString(reinterpret_cast<PGM_P>(text), true, width);
+}
+
+// Like clipText, the current font is drawn at its original size, and the text is not wrapped.
+// Characters the font does not include are skipped.
+void SSD1306Device::renderString(const char *text, bool progmem, uint8_t width) {
+	uint8_t h = oledFont->height;
+	uint8_t remaining = oledWidth - oledX;
+	if (width > remaining) width = remaining;
+	ssd1306_send_window_start(h);
+	while (width) {
+		unsigned char c = progmem ? pgm_read_byte(text) : *text;
+		text++;
+		if (c == 0) break;
+		if (c < oledFont->first || c > oledFont->last) continue;
+
+		uint8_t w = getCharacterWidth(c);
+		uint8_t columns = w < width ? w : width;
+		sendCharacterColumns(c, 0, columns);
+		width -= columns;
+
+		uint8_t spacing = characterSpacing;
+		if (spacing > width) spacing = width;
+		ssd1306_send_window_columns(0, 0, spacing, h);
+		width -= spacing;
+	}
+	ssd1306_send_stop();
 }
 
 void SSD1306Device::clipTextP(uint16_t startPixel, uint8_t width, DATACUTE_F_MACRO_T *text) {
+	SSD1306_SELECT();
 	uint8_t h = oledFont->height;
 	PGM_P p = reinterpret_cast<PGM_P>(text);
 	uint8_t drawnColumns = 0;
@@ -704,6 +1952,7 @@ void SSD1306Device::clipTextP(uint16_t startPixel, uint8_t width, DATACUTE_F_MAC
 	// If beyond the end of the string, write 0s/spaces
 	// However, it probably takes less bytes currently to simply put spaces at the beginning or end of the text.
 	uint16_t initialSkip = startPixel;
+	ssd1306_send_window_start(h);
 	while (drawnColumns < width) {
 		unsigned char c = pgm_read_byte(p++);
 		if (c == 0) break;
@@ -727,24 +1976,8 @@ void SSD1306Device::clipTextP(uint16_t startPixel, uint8_t width, DATACUTE_F_MAC
 			if (drawnColumns + spacing > width) {
 				spacing = width - drawnColumns;
 			}
-			//if (spacing > 0) {
-				uint8_t line = h;
-				do
-				{
-					ssd1306_send_data_start();
-					repeatData(0, spacing);
-					ssd1306_send_stop();
-					if (h > 1) {
-						if (line > 1) {
-							setCursor(oledX, oledY + 1);
-						}
-						else {
-							setCursor(oledX + spacing, oledY - (h - 1));
-						}
-					}
-				} while (--line);
-				drawnColumns += spacing;
-			//}
+			ssd1306_send_window_columns(0, 0, spacing, h);
+			drawnColumns += spacing;
 			initialSkip = 0;
 			continue;
 		}
@@ -759,63 +1992,213 @@ void SSD1306Device::clipTextP(uint16_t startPixel, uint8_t width, DATACUTE_F_MAC
 			}
 		}
 
-		uint16_t offset = getCharacterDataOffset(c);
-		uint8_t line = h;
-		do
-		{
-			offset += initialSkip;
-			ssd1306_send_data_start();
-			for (uint8_t i = 0; (i < w - initialSkip) && ((drawnColumns + i) < width); i++) {
-				ssd1306_send_data_byte(pgm_read_byte(&(oledFont->bitmap[offset + i])));
+		uint8_t columns = w - initialSkip;
+		if (columns > width - drawnColumns) {
+			columns = width - drawnColumns;
+		}
+		sendCharacterColumns(c, initialSkip, columns);
+		ssd1306_send_window_columns(0, 0, spacing, h);
+		drawnColumns += columns + spacing;
+		initialSkip = 0;
+	}
+	ssd1306_send_stop();
+}
+
+// Marquee
+
+// Starts a marquee at the cursor, width columns wide and as high as the current font,
+// and draws the first columns of its text, which then scrolls one column with each step.
+// The marquee remembers its place in the text, so each step only sends the newly revealed column.
+// Text is decoded as UTF-8 when a unicode font is selected.
+void SSD1306Device::startMarquee(DCMarquee *marquee, const char *text, uint8_t width) {
+	SSD1306_SELECT();
+	beginMarquee(marquee, text, false, width);
+}
+
+void SSD1306Device::startMarquee(DCMarquee *marquee, DATACUTE_F_MACRO_T *text, uint8_t width) {
+	SSD1306_SELECT();
+	beginMarquee(marquee, reinterpret_cast<PGM_P>(text), true, width);
+}
+
+void SSD1306Device::beginMarquee(DCMarquee *marquee, const char *text, bool progmem, uint8_t width) {
+	uint8_t remaining = oledWidth - oledX;
+	if (width > remaining) width = remaining;
+	marquee->text = text;
+	marquee->next = text;
+	marquee->progmem = progmem;
+#ifdef TINY4KOLED_NO_UNICODE
+	marquee->utf8 = false;
+#else
+	marquee->utf8 = oledUnicodeFont && decodeFn == &SSD1306Device::decodeUtf8Internal;
+#endif
+	marquee->x = oledX;
+	marquee->y = oledY;
+	marquee->width = width;
+	marquee->height = oledFont->height;
+	marquee->font = oledFont;
+	marquee->spacing = characterSpacing;
+	marquee->columns = 0;
+	marquee->column = 0;
+	sendMarqueeColumns(marquee, width);
+}
+
+// Shifts the content of the marquee's region one column left.
+// The display performs the shift as it next refreshes, so wait for that before calling drawMarquee.
+void SSD1306Device::scrollMarquee(DCMarquee *marquee) {
+	SSD1306_SELECT();
+	scrollContentLeft(marquee->y, marquee->y + marquee->height - 1, marquee->x, marquee->x + marquee->width - 1);
+}
+
+// Draws the next column of the text in the right hand column of the marquee.
+void SSD1306Device::drawMarquee(DCMarquee *marquee) {
+	SSD1306_SELECT();
+	uint8_t x = oledX;
+	uint8_t y = oledY;
+	ssd1306_move_cursor(marquee->x + marquee->width - 1, marquee->y);
+	sendMarqueeColumns(marquee, 1);
+	ssd1306_move_cursor(x, y);
+}
+
+// Reads the marquee's next character, returning to the start of the text at its end.
+// Characters the font does not include are skipped.
+void SSD1306Device::readMarqueeCharacter(DCMarquee *marquee) {
+	bool wrapped = false;
+	marquee->column = 0;
+	for (;;) {
+		unsigned char c = marquee->progmem ? pgm_read_byte(marquee->next) : *marquee->next;
+		if (c == 0) {
+			// A text without any characters to draw scrolls as blank columns
+			if (wrapped) break;
+			wrapped = true;
+			marquee->next = marquee->text;
+			continue;
+		}
+		marquee->next++;
+
+		if (!marquee->utf8) {
+			if (c < marquee->font->first || c > marquee->font->last) continue;
+			oledFont = marquee->font;
+		}
+#ifndef TINY4KOLED_NO_UNICODE
+		else {
+			uint32_t codepoint = c;
+			uint8_t continuation = 0;
+			if (c >= 0xF0) {
+				codepoint = c & 0x07;
+				continuation = 3;
+			} else if (c >= 0xE0) {
+				codepoint = c & 0x0F;
+				continuation = 2;
+			} else if (c >= 0xC0) {
+				codepoint = c & 0x1F;
+				continuation = 1;
 			}
-			repeatData(0, spacing);
-			ssd1306_send_stop();
-			offset += w - initialSkip;
-			if (h > 1) {
-				if (line > 1) {
-					setCursor(oledX, oledY + 1);
-				}
-				else {
-					setCursor(oledX + w + spacing, oledY - (h - 1));
-				}
+			while (continuation) {
+				c = marquee->progmem ? pgm_read_byte(marquee->next) : *marquee->next;
+				if ((c & 0xC0) != 0x80) break;
+				marquee->next++;
+				codepoint = (codepoint << 6) | (c & 0x3F);
+				continuation--;
 			}
-		} while (--line);
-		drawnColumns += w - initialSkip + spacing;
-		initialSkip = 0;
+			if (continuation || codepoint < ' ') continue;
+			if (codepoint == ' ') {
+				marquee->glyphColumns = 0;
+				marquee->columns = oledUnicodeFont->space_width + marquee->spacing;
+				if (marquee->columns) return;
+				continue;
+			}
+			unicodeCodepoint.codepoint = codepoint;
+			if (!SelectUnicodeBlock()) continue;
+			const DCfont *font = oledUnicodeFont->fonts[unicodeFontNum].font;
+			if (font != marquee->font) {
+				setFontOnly(font);
+				marquee->font = font;
+				marquee->spacing = characterSpacing;
+			}
+			c = unicodeCodepoint.unicode.offset;
+		}
+#endif
+
+		marquee->c = c;
+		marquee->glyphColumns = getCharacterWidth(c);
+		marquee->columns = marquee->glyphColumns + marquee->spacing;
+		if (marquee->columns) return;
 	}
+	marquee->glyphColumns = 0;
+	marquee->columns = 1;
+}
+
+// Sends the marquee's next columns at the cursor, reading further characters as they are needed.
+// The current font is left unchanged.
+void SSD1306Device::sendMarqueeColumns(DCMarquee *marquee, uint8_t count) {
+	const DCfont *font = oledFont;
+	uint8_t spacing = characterSpacing;
+	uint32_t codepoint = unicodeCodepoint.codepoint;
+	uint8_t fontNum = unicodeFontNum;
+	uint8_t h = marquee->height;
+	ssd1306_send_window_start(h);
+	while (count) {
+		if (marquee->column >= marquee->columns) readMarqueeCharacter(marquee);
+		oledFont = marquee->font;
+		uint8_t columns;
+		if (marquee->column < marquee->glyphColumns) {
+			columns = marquee->glyphColumns - marquee->column;
+			if (columns > count) columns = count;
+			sendCharacterColumns(marquee->c, marquee->column, columns);
+		} else {
+			columns = marquee->columns - marquee->column;
+			if (columns > count) columns = count;
+			ssd1306_send_window_columns(0, 0, columns, h);
+		}
+		marquee->column += columns;
+		count -= columns;
+	}
+	ssd1306_send_stop();
+	oledFont = font;
+	characterSpacing = spacing;
+	unicodeCodepoint.codepoint = codepoint;
+	unicodeFontNum = fontNum;
 }
 
 // Double Buffering Commands
 
 void SSD1306Device::switchRenderFrame(void) {
+	SSD1306_SELECT();
 	renderingFrame ^= 0x04;
+	ssd1306_cursor_relocated();
 }
 
 void SSD1306Device::switchDisplayFrame(void) {
+	SSD1306_SELECT();
 	drawingFrame ^= 0x20;
 	ssd1306_send_command(drawingFrame);
 }
 
 void SSD1306Device::switchFrame(void) {
+	SSD1306_SELECT();
 	switchDisplayFrame();
 	switchRenderFrame();
 }
 
 uint8_t SSD1306Device::currentRenderFrame(void) {
+	SSD1306_SELECT();
 	return (renderingFrame >> 2) & 0x01;
 }
 
 uint8_t SSD1306Device::currentDisplayFrame(void) {
+	SSD1306_SELECT();
 	return (drawingFrame >> 5) & 0x01;
 }
 
 // 1. Fundamental Command Table
 
 void SSD1306Device::setContrast(uint8_t contrast) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0x81,contrast);
 }
 
 void SSD1306Device::setEntireDisplayOn(bool enable) {
+	SSD1306_SELECT();
 	if (enable)
 		ssd1306_send_command(0xA5);
 	else
@@ -823,6 +2206,7 @@ void SSD1306Device::setEntireDisplayOn(bool enable) {
 }
 
 void SSD1306Device::setInverse(bool enable) {
+	SSD1306_SELECT();
 	if (enable)
 		ssd1306_send_command(0xA7);
 	else
@@ -830,154 +2214,199 @@ void SSD1306Device::setInverse(bool enable) {
 }
 
 void SSD1306Device::setExternalIref(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xAD, 0x00);
 }
 
 void SSD1306Device::setInternalIref(bool bright) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xAD, ((bright & 0x01) << 5) | 0x10);
 }
 
 void SSD1306Device::off(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0xAE);
 }
 
 void SSD1306Device::on(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0xAF);
 }
 
 // 2. Scrolling Command Table
 
 void SSD1306Device::scrollRight(uint8_t startPage, uint8_t interval, uint8_t endPage, uint8_t startColumn, uint8_t endColumn) {
+	SSD1306_SELECT();
 	ssd1306_send_command7(0x26, 0x00, startPage + oledOffsetY, interval, endPage + oledOffsetY, startColumn, endColumn);
 }
 
 void SSD1306Device::scrollLeft(uint8_t startPage, uint8_t interval, uint8_t endPage, uint8_t startColumn, uint8_t endColumn) {
+	SSD1306_SELECT();
 	ssd1306_send_command7(0x27, 0x00, startPage + oledOffsetY, interval, endPage + oledOffsetY, startColumn, endColumn);
 }
 
 void SSD1306Device::scrollRightOffset(uint8_t startPage, uint8_t interval, uint8_t endPage, uint8_t offset) {
+	SSD1306_SELECT();
 	ssd1306_send_command6(0x29, 0x00, startPage + oledOffsetY, interval, endPage + oledOffsetY, offset);
 }
 
 void SSD1306Device::scrollLeftOffset(uint8_t startPage, uint8_t interval, uint8_t endPage, uint8_t offset) {
+	SSD1306_SELECT();
 	ssd1306_send_command6(0x2A, 0x00, startPage + oledOffsetY, interval, endPage + oledOffsetY, offset);
 }
 
 void SSD1306Device::scrollContentRight(uint8_t startPage, uint8_t endPage, uint8_t startColumn, uint8_t endColumn) {
+	SSD1306_SELECT();
 	ssd1306_send_command7(0x2C, 0x00, startPage + oledOffsetY, 0x01, endPage + oledOffsetY, startColumn + oledOffsetX, endColumn + oledOffsetX);
 }
 
 void SSD1306Device::scrollContentLeft(uint8_t startPage, uint8_t endPage, uint8_t startColumn, uint8_t endColumn) {
+	SSD1306_SELECT();
 	ssd1306_send_command7(0x2D, 0x00, startPage + oledOffsetY, 0x01, endPage + oledOffsetY, startColumn + oledOffsetX, endColumn + oledOffsetX);
 }
 
 void SSD1306Device::deactivateScroll(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0x2E);
 }
 
 void SSD1306Device::activateScroll(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0x2F);
 }
 
 void SSD1306Device::setVerticalScrollArea(uint8_t top, uint8_t rows) {
+	SSD1306_SELECT();
 	ssd1306_send_command3(0xA3, top, rows);
 }
 
 // 3. Addressing Setting Command Table
 
 void SSD1306Device::setColumnStartAddress(uint8_t startAddress) {
+	SSD1306_SELECT();
+	ssd1306_send_pending_cursor();
+	pointerAtCursor = false;
 	ssd1306_send_command2(startAddress & 0x0F, startAddress >> 4);
 }
 
 void SSD1306Device::setMemoryAddressingMode(uint8_t mode) {
+	SSD1306_SELECT();
+	ssd1306_send_pending_cursor();
+	pointerAtCursor = false;
 	ssd1306_send_command2(0x20, mode & 0x03);
 }
 
 void SSD1306Device::setColumnAddress(uint8_t startAddress, uint8_t endAddress) {
+	SSD1306_SELECT();
+	ssd1306_send_pending_cursor();
+	pointerAtCursor = false;
 	ssd1306_send_command3(0x21, startAddress & 0x7F, endAddress & 0x7F);
 }
 
 void SSD1306Device::setPageAddress(uint8_t startPage, uint8_t endPage) {
+	SSD1306_SELECT();
+	ssd1306_send_pending_cursor();
+	pointerAtCursor = false;
 	ssd1306_send_command3(0x22, startPage & 0x07, endPage & 0x07);
 }
 
 void SSD1306Device::setPageStartAddress(uint8_t startPage) {
+	SSD1306_SELECT();
+	ssd1306_send_pending_cursor();
+	pointerAtCursor = false;
 	ssd1306_send_command(0xB0 | (startPage & 0x07));
 }
 
 // 4. Hardware Configuration (Panel resolution and layout related) Command Table
 
 void SSD1306Device::setDisplayStartLine(uint8_t startLine) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0x40 | (startLine & 0x3F));
 }
 
 void SSD1306Device::setSegmentRemap(uint8_t remap) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0xA0 | (remap & 0x01));
 }
 
 void SSD1306Device::setMultiplexRatio(uint8_t mux) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xA8, (mux - 1) & 0x3F);
 }
 
 void SSD1306Device::setComOutputDirection(uint8_t direction) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0xC0 | ((direction & 0x01) << 3));
 }
 
 void SSD1306Device::setDisplayOffset(uint8_t offset) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xD3, offset & 0x3F);
 }
 
 void SSD1306Device::setComPinsHardwareConfiguration(uint8_t alternative, uint8_t enableLeftRightRemap) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xDA, ((enableLeftRightRemap & 0x01) << 5) | ((alternative & 0x01) << 4) | 0x02 );
 }
 
 // 5. Timing and Driving Scheme Setting Command table
 
 void SSD1306Device::setDisplayClock(uint8_t divideRatio, uint8_t oscillatorFrequency) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xD5, ((oscillatorFrequency & 0x0F) << 4) | ((divideRatio -1) & 0x0F));
 }
 
 void SSD1306Device::setPrechargePeriod(uint8_t phaseOnePeriod, uint8_t phaseTwoPeriod) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xD9, ((phaseTwoPeriod & 0x0F) << 4) | (phaseOnePeriod & 0x0F));
 }
 
 void SSD1306Device::setVcomhDeselectLevel(uint8_t level) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xDB, (level & 0x07) << 4);
 }
 
 void SSD1306Device::nop(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command(0xE3);
 }
 
 // 6. Advance Graphic Command table
 
 void SSD1306Device::fadeOut(uint8_t interval) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0x23, (0x20 | (interval & 0x0F)));
 }
 
 void SSD1306Device::blink(uint8_t interval) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0x23, (0x30 | (interval & 0x0F)));
 }
 
 void SSD1306Device::disableFadeOutAndBlinking(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0x23, 0x00);
 }
 
 void SSD1306Device::enableZoomIn(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xD6, 0x01);
 }
 
 void SSD1306Device::disableZoomIn(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0xD6, 0x00);
 }
 
 // Charge Pump Settings
 
 void SSD1306Device::enableChargePump(uint8_t voltage) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0x8D, ((voltage | 0x14) & 0xD5));
 }
 
 void SSD1306Device::disableChargePump(void) {
+	SSD1306_SELECT();
 	ssd1306_send_command2(0x8D, 0x10);
 }
 
@@ -0,0 +1,152 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ * This file adds support for displays wired for 4-wire SPI, using the SPI library,
+ * which on the ATtiny cores is implemented with the USI in three-wire mode.
+ * There is no control byte in SPI. Instead the D/C# pin selects whether bytes
+ * are commands or data. The control bytes the library writes are turned into
+ * the level of the D/C# pin, rather than being sent.
+ *
+ * Another bus, such as the emulator, can be supplied by defining TINY4KOLED_SPI_BUS,
+ * and the four tiny4koled_spi_bus functions declared below.
+ */
+#ifndef TINY4KOLED_SPI_H
+#define TINY4KOLED_SPI_H
+
+#include "Tiny4kOLED_common.h"
+
+// The pins the display is wired to. CS and RESET can be -1 when they are not connected.
+#ifndef TINY4KOLED_SPI_DC
+#define TINY4KOLED_SPI_DC 9
+#endif
+#ifndef TINY4KOLED_SPI_CS
+#define TINY4KOLED_SPI_CS 10
+#endif
+#ifndef TINY4KOLED_SPI_RESET
+#define TINY4KOLED_SPI_RESET 8
+#endif
+
+// The SSD1306 accepts a clock of up to 10MHz.
+#ifndef TINY4KOLED_SPI_CLOCK
+#define TINY4KOLED_SPI_CLOCK 8000000L
+#endif
+
+static void tiny4koled_spi_bus_begin(void);
+static void tiny4koled_spi_bus_select(bool selected);
+static void tiny4koled_spi_bus_dc(bool data);
+static void tiny4koled_spi_bus_transfer(uint8_t byte);
+
+#ifndef TINY4KOLED_SPI_BUS
+
+#include <SPI.h>
+
+static void tiny4koled_spi_bus_begin(void) {
+	pinMode(TINY4KOLED_SPI_DC, OUTPUT);
+#if TINY4KOLED_SPI_CS >= 0
+	digitalWrite(TINY4KOLED_SPI_CS, HIGH);
+	pinMode(TINY4KOLED_SPI_CS, OUTPUT);
+#endif
+	SPI.begin();
+#if TINY4KOLED_SPI_RESET >= 0
+	// The controller is reset by holding RES# low for at least 3us.
+	pinMode(TINY4KOLED_SPI_RESET, OUTPUT);
+	digitalWrite(TINY4KOLED_SPI_RESET, LOW);
+	delay(1);
+	digitalWrite(TINY4KOLED_SPI_RESET, HIGH);
+	delay(1);
+#endif
+}
+
+static void tiny4koled_spi_bus_select(bool selected) {
+	if (selected) {
+		SPI.beginTransaction(SPISettings(TINY4KOLED_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+#if TINY4KOLED_SPI_CS >= 0
+		digitalWrite(TINY4KOLED_SPI_CS, LOW);
+#endif
+	} else {
+#if TINY4KOLED_SPI_CS >= 0
+		digitalWrite(TINY4KOLED_SPI_CS, HIGH);
+#endif
+		SPI.endTransaction();
+	}
+}
+
+static void tiny4koled_spi_bus_dc(bool data) {
+	digitalWrite(TINY4KOLED_SPI_DC, data ? HIGH : LOW);
+}
+
+static void tiny4koled_spi_bus_transfer(uint8_t byte) {
+	SPI.transfer(byte);
+}
+
+#endif
+
+// The library's control bytes are decoded as the emulator does.
+static bool tiny4koled_spi_control_expected = false;
+static bool tiny4koled_spi_continuation = false; // Co=1, so only the next byte is of the type selected
+static uint8_t tiny4koled_spi_dc = 0xFF; // the level of the D/C# pin, 0xFF until it is first set
+
+static bool tiny4koled_beginTransmission_spi(void) {
+	tiny4koled_spi_bus_select(true);
+	tiny4koled_spi_control_expected = true;
+	return true;
+}
+
+static bool tiny4koled_write_spi(uint8_t byte) {
+	if (tiny4koled_spi_control_expected) {
+		uint8_t dc = (byte & 0x40) ? 1 : 0;
+		if (dc != tiny4koled_spi_dc) {
+			tiny4koled_spi_bus_dc(dc);
+			tiny4koled_spi_dc = dc;
+		}
+		tiny4koled_spi_continuation = byte & 0x80;
+		tiny4koled_spi_control_expected = false;
+		return true;
+	}
+	tiny4koled_spi_bus_transfer(byte);
+	if (tiny4koled_spi_continuation) tiny4koled_spi_control_expected = true;
+	return true;
+}
+
+static uint8_t tiny4koled_endTransmission_spi(void) {
+	tiny4koled_spi_bus_select(false);
+	return 0;
+}
+
+// The library only writes blocks after a control byte that selects the rest of the transaction.
+static uint16_t tiny4koled_repeat_spi(uint8_t byte, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		tiny4koled_spi_bus_transfer(byte);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlock_spi(const uint8_t *bytes, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		tiny4koled_spi_bus_transfer(bytes[i]);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlockP_spi(const uint8_t *bytes, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		tiny4koled_spi_bus_transfer(pgm_read_byte(&bytes[i]));
+	}
+	return count;
+}
+
+static void tiny4koled_begin_spi(void) {
+	tiny4koled_spi_dc = 0xFF;
+	tiny4koled_spi_bus_begin();
+}
+
+#ifndef TINY4KOLED_NO_PRINT
+SSD1306PrintDevice oled(&tiny4koled_begin_spi, &tiny4koled_beginTransmission_spi, &tiny4koled_write_spi, &tiny4koled_endTransmission_spi, &tiny4koled_repeat_spi, &tiny4koled_writeBlock_spi, &tiny4koled_writeBlockP_spi);
+#else
+SSD1306Device oled(&tiny4koled_begin_spi, &tiny4koled_beginTransmission_spi, &tiny4koled_write_spi, &tiny4koled_endTransmission_spi, &tiny4koled_repeat_spi, &tiny4koled_writeBlock_spi, &tiny4koled_writeBlockP_spi);
+#endif
+
+#endif
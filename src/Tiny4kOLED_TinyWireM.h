@@ -14,6 +14,11 @@
 #include <TinyWireM.h>
 #include "Tiny4kOLED_common.h"
 
+// The first byte of TinyWireM's buffer holds the address.
+#ifndef TINY4KOLED_TINYWIREM_BUFFER_LENGTH
+#define TINY4KOLED_TINYWIREM_BUFFER_LENGTH (USI_BUF_SIZE - 1)
+#endif
+
 #ifndef DATACUTE_I2C_TINYWIREM
 #define DATACUTE_I2C_TINYWIREM
 
@@ -36,7 +41,7 @@ static uint8_t datacute_endTransmission_tinywirem(void) {
 #endif
 
 static bool tiny4koled_beginTransmission_tinywirem(void) {
-	TinyWireM.beginTransmission(SSD1306);
+	TinyWireM.beginTransmission(TINY4KOLED_ADDRESS);
 	return true;
 }
 
@@ -58,9 +63,9 @@ static void tiny4koled_begin_tinywirem(void) {
 }
 
 #ifndef TINY4KOLED_NO_PRINT
-SSD1306PrintDevice oled(&tiny4koled_begin_tinywirem, &tiny4koled_beginTransmission_tinywirem, &datacute_write_tinywirem, &datacute_endTransmission_tinywirem);
+SSD1306PrintDevice oled(&tiny4koled_begin_tinywirem, &tiny4koled_beginTransmission_tinywirem, &datacute_write_tinywirem, &datacute_endTransmission_tinywirem, 0, 0, 0, TINY4KOLED_TINYWIREM_BUFFER_LENGTH);
 #else
-SSD1306Device oled(&tiny4koled_begin_tinywirem, &tiny4koled_beginTransmission_tinywirem, &datacute_write_tinywirem, &datacute_endTransmission_tinywirem);
+SSD1306Device oled(&tiny4koled_begin_tinywirem, &tiny4koled_beginTransmission_tinywirem, &datacute_write_tinywirem, &datacute_endTransmission_tinywirem, 0, 0, 0, TINY4KOLED_TINYWIREM_BUFFER_LENGTH);
 #endif
 
 #endif
@@ -11,6 +11,17 @@
 #include <Wire.h>
 #include "Tiny4kOLED_common.h"
 
+// The number of bytes the Wire library can buffer in one transmission.
+#ifndef TINY4KOLED_WIRE_BUFFER_LENGTH
+#if defined(BUFFER_LENGTH)
+#define TINY4KOLED_WIRE_BUFFER_LENGTH BUFFER_LENGTH
+#elif defined(I2C_BUFFER_LENGTH)
+#define TINY4KOLED_WIRE_BUFFER_LENGTH I2C_BUFFER_LENGTH
+#else
+#define TINY4KOLED_WIRE_BUFFER_LENGTH 16
+#endif
+#endif
+
 #ifndef DATACUTE_I2C_WIRE
 #define DATACUTE_I2C_WIRE
 
@@ -33,7 +44,7 @@ static uint8_t datacute_endTransmission_wire(void) {
 #endif
 
 static bool tiny4koled_beginTransmission_wire(void) {
-	Wire.beginTransmission(SSD1306);
+	Wire.beginTransmission(TINY4KOLED_ADDRESS);
 	return true;
 }
 
@@ -45,6 +56,24 @@ inline static bool tiny4koled_check_wire(void) {
 }
 #endif
 
+static uint16_t tiny4koled_repeat_wire(uint8_t byte, uint16_t count) {
+	uint16_t sent = 0;
+	while (sent < count && Wire.write(byte)) sent++;
+	return sent;
+}
+
+// TwoWire::write(const uint8_t *, size_t) reports the full length even when its buffer overflows,
+// but the library never passes more than fits within TINY4KOLED_WIRE_BUFFER_LENGTH.
+static uint16_t tiny4koled_writeBlock_wire(const uint8_t *bytes, uint16_t count) {
+	return Wire.write(bytes, count);
+}
+
+static uint16_t tiny4koled_writeBlockP_wire(const uint8_t *bytes, uint16_t count) {
+	uint16_t sent = 0;
+	while (sent < count && Wire.write(pgm_read_byte(&bytes[sent]))) sent++;
+	return sent;
+}
+
 static void tiny4koled_begin_wire(void) {
 	Wire.begin();
 #ifndef TINY4KOLED_QUICK_BEGIN
@@ -55,9 +84,9 @@ static void tiny4koled_begin_wire(void) {
 }
 
 #ifndef TINY4KOLED_NO_PRINT
-SSD1306PrintDevice oled(&tiny4koled_begin_wire, &tiny4koled_beginTransmission_wire, &datacute_write_wire, &datacute_endTransmission_wire);
+SSD1306PrintDevice oled(&tiny4koled_begin_wire, &tiny4koled_beginTransmission_wire, &datacute_write_wire, &datacute_endTransmission_wire, &tiny4koled_repeat_wire, &tiny4koled_writeBlock_wire, &tiny4koled_writeBlockP_wire, TINY4KOLED_WIRE_BUFFER_LENGTH);
 #else
-SSD1306Device oled(&tiny4koled_begin_wire, &tiny4koled_beginTransmission_wire, &datacute_write_wire, &datacute_endTransmission_wire);
+SSD1306Device oled(&tiny4koled_begin_wire, &tiny4koled_beginTransmission_wire, &datacute_write_wire, &datacute_endTransmission_wire, &tiny4koled_repeat_wire, &tiny4koled_writeBlock_wire, &tiny4koled_writeBlockP_wire, TINY4KOLED_WIRE_BUFFER_LENGTH);
 #endif
 
 #endif
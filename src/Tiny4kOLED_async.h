@@ -0,0 +1,385 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ * This file adds an interrupt driven transport, so that drawing doesn't wait for the bus.
+ * The bytes written are queued as transfers in a ring, which an interrupt driven engine
+ * sends in the background. Bytes from RAM are copied into the transfers, while blocks
+ * from PROGMEM and repeated bytes are queued as a pointer or a count.
+ * Drawing only waits when the ring is full.
+ *
+ * The engine supplied drives the TWI peripheral of the ATmega parts, such as the ATmega328P.
+ * There is no engine for the USI of ATtiny parts, such as the ATtiny85, as the USI does not
+ * generate the I2C clock itself. On those parts the header stops with an error.
+ * Another engine, such as a simulated one for host builds, can be supplied by defining
+ * TINY4KOLED_ASYNC_ENGINE, and the two functions it names below.
+ */
+#ifndef TINY4KOLED_ASYNC_H
+#define TINY4KOLED_ASYNC_H
+
+#include "Tiny4kOLED_common.h"
+
+// The number of transfers the ring holds, a power of two. One is always left empty.
+#ifndef TINY4KOLED_ASYNC_QUEUE_LENGTH
+#define TINY4KOLED_ASYNC_QUEUE_LENGTH 16
+#endif
+
+#if (TINY4KOLED_ASYNC_QUEUE_LENGTH & (TINY4KOLED_ASYNC_QUEUE_LENGTH - 1)) || TINY4KOLED_ASYNC_QUEUE_LENGTH < 4
+#error TINY4KOLED_ASYNC_QUEUE_LENGTH must be a power of two, of at least 4
+#endif
+
+// The number of bytes from RAM that each transfer holds.
+#ifndef TINY4KOLED_ASYNC_INLINE_BYTES
+#define TINY4KOLED_ASYNC_INLINE_BYTES 4
+#endif
+
+#ifndef TINY4KOLED_ASYNC_CLOCK
+#define TINY4KOLED_ASYNC_CLOCK 100000L
+#endif
+
+// Called while waiting for the engine to make room in the ring, or to finish.
+// Interrupts must be enabled, so an interrupt driven engine needs nothing here.
+#ifndef TINY4KOLED_ASYNC_WAIT
+#define TINY4KOLED_ASYNC_WAIT()
+#endif
+
+// Transfer types
+#define TINY4KOLED_ASYNC_START 1
+#define TINY4KOLED_ASYNC_STOP 2
+#define TINY4KOLED_ASYNC_BYTES 3
+#define TINY4KOLED_ASYNC_PROGMEM 4
+#define TINY4KOLED_ASYNC_REPEAT 5
+#define TINY4KOLED_ASYNC_CALLBACK 6
+
+// The events the engine is given, other than those transfer types.
+#define TINY4KOLED_ASYNC_NONE 0 // nothing more has been queued yet
+#define TINY4KOLED_ASYNC_BYTE 3
+
+typedef struct DCAsyncTransfer {
+	uint8_t type;
+	uint8_t length; // the number of inline bytes
+	union {
+		uint8_t address;
+		uint8_t bytes[TINY4KOLED_ASYNC_INLINE_BYTES];
+		struct {
+			const uint8_t *bytes;
+			uint16_t count;
+		} block;
+		struct {
+			uint8_t byte;
+			uint16_t count;
+		} repeat;
+		void (*callback)(void);
+	};
+} DCAsyncTransfer;
+
+typedef struct DCAsyncQueue {
+	DCAsyncTransfer ring[TINY4KOLED_ASYNC_QUEUE_LENGTH];
+	volatile uint8_t head; // written by the drawing code. ring[head] is the transfer being filled.
+	volatile uint8_t tail; // written by the engine. ring[tail] is the transfer being sent.
+	uint16_t sent; // the number of bytes of ring[tail] already sent
+	volatile bool running; // false when the engine has stopped, waiting to be kicked
+	bool filling; // true while ring[head] holds bytes that have not been queued
+	volatile bool discarding; // true while the rest of a transaction that was not acknowledged is dropped
+	volatile uint8_t nacks; // the number of transactions that were not acknowledged
+} DCAsyncQueue;
+
+static DCAsyncQueue tiny4koled_async;
+
+#define TINY4KOLED_ASYNC_MASK (TINY4KOLED_ASYNC_QUEUE_LENGTH - 1)
+
+// Supplied by the engine
+static void tiny4koled_async_engine_begin(void);
+// Restarts the engine after it has stopped, from outside the interrupt.
+static void tiny4koled_async_engine_kick(void);
+
+// ----------------------------------------------------------------------------
+// The engine's side of the queue. These are called from the interrupt, or while it is disabled.
+
+static void tiny4koled_async_done(void) {
+	tiny4koled_async.sent = 0;
+	tiny4koled_async.tail = (tiny4koled_async.tail + 1) & TINY4KOLED_ASYNC_MASK;
+}
+
+// Runs the queued callbacks, and drops the rest of a transaction that was not acknowledged.
+// Returns true when a transfer is waiting to be sent.
+static bool tiny4koled_async_pending(void) {
+	DCAsyncQueue &q = tiny4koled_async;
+	while (q.tail != q.head) {
+		DCAsyncTransfer &t = q.ring[q.tail];
+		if (t.type == TINY4KOLED_ASYNC_CALLBACK) {
+			void (*callback)(void) = t.callback;
+			tiny4koled_async_done();
+			callback();
+		}
+		else if (q.discarding) {
+			if (t.type == TINY4KOLED_ASYNC_STOP) q.discarding = false;
+			tiny4koled_async_done();
+		}
+		else {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Returns the next event to put on the bus, and its byte.
+// When nothing more has been queued, the engine is marked as stopped, and must wait to be kicked.
+static uint8_t tiny4koled_async_next(uint8_t *byte) {
+	DCAsyncQueue &q = tiny4koled_async;
+	if (!tiny4koled_async_pending()) {
+		q.running = false;
+		return TINY4KOLED_ASYNC_NONE;
+	}
+	DCAsyncTransfer &t = q.ring[q.tail];
+	uint8_t type = t.type;
+	switch (type) {
+		case TINY4KOLED_ASYNC_START:
+			*byte = t.address;
+			tiny4koled_async_done();
+			return TINY4KOLED_ASYNC_START;
+		case TINY4KOLED_ASYNC_BYTES:
+			*byte = t.bytes[q.sent++];
+			if (q.sent == t.length) tiny4koled_async_done();
+			return TINY4KOLED_ASYNC_BYTE;
+		case TINY4KOLED_ASYNC_PROGMEM:
+			*byte = pgm_read_byte(&t.block.bytes[q.sent++]);
+			if (q.sent == t.block.count) tiny4koled_async_done();
+			return TINY4KOLED_ASYNC_BYTE;
+		case TINY4KOLED_ASYNC_REPEAT:
+			*byte = t.repeat.byte;
+			if (++q.sent == t.repeat.count) tiny4koled_async_done();
+			return TINY4KOLED_ASYNC_BYTE;
+	}
+	tiny4koled_async_done();
+	return TINY4KOLED_ASYNC_STOP;
+}
+
+// ----------------------------------------------------------------------------
+// The drawing code's side of the queue.
+
+// Hands ring[head] to the engine, waiting for room in the ring first.
+static void tiny4koled_async_queue(void) {
+	DCAsyncQueue &q = tiny4koled_async;
+	uint8_t next = (q.head + 1) & TINY4KOLED_ASYNC_MASK;
+	while (next == q.tail) {
+		TINY4KOLED_ASYNC_WAIT();
+	}
+	// The transfer must be complete in RAM before the engine can see it.
+	__asm__ __volatile__ ("" ::: "memory");
+	q.head = next;
+	q.filling = false;
+	if (!q.running) {
+		tiny4koled_async_engine_kick();
+	}
+}
+
+static void tiny4koled_async_end_filling(void) {
+	if (tiny4koled_async.filling) tiny4koled_async_queue();
+}
+
+static DCAsyncTransfer &tiny4koled_async_transfer(uint8_t type) {
+	tiny4koled_async_end_filling();
+	DCAsyncTransfer &t = tiny4koled_async.ring[tiny4koled_async.head];
+	t.type = type;
+	return t;
+}
+
+static bool tiny4koled_beginTransmission_async(void) {
+	tiny4koled_async_transfer(TINY4KOLED_ASYNC_START).address = TINY4KOLED_ADDRESS;
+	tiny4koled_async_queue();
+	return true;
+}
+
+static bool tiny4koled_write_async(uint8_t byte) {
+	DCAsyncQueue &q = tiny4koled_async;
+	DCAsyncTransfer &t = q.ring[q.head];
+	if (!q.filling) {
+		t.type = TINY4KOLED_ASYNC_BYTES;
+		t.length = 0;
+		q.filling = true;
+	}
+	t.bytes[t.length++] = byte;
+	// Bytes are collected until the transfer is full, unless the engine is waiting for them.
+	if (t.length == TINY4KOLED_ASYNC_INLINE_BYTES || !q.running) {
+		tiny4koled_async_queue();
+	}
+	return true;
+}
+
+static uint8_t tiny4koled_endTransmission_async(void) {
+	tiny4koled_async_transfer(TINY4KOLED_ASYNC_STOP);
+	tiny4koled_async_queue();
+	// Transactions that are not acknowledged are counted in tiny4koled_async.nacks
+	return 0;
+}
+
+static uint16_t tiny4koled_repeat_async(uint8_t byte, uint16_t count) {
+	if (count == 0) return 0;
+	DCAsyncTransfer &t = tiny4koled_async_transfer(TINY4KOLED_ASYNC_REPEAT);
+	t.repeat.byte = byte;
+	t.repeat.count = count;
+	tiny4koled_async_queue();
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlock_async(const uint8_t *bytes, uint16_t count) {
+	// The bytes are copied, as the RAM they are in might be reused as soon as this returns.
+	for (uint16_t i = 0; i < count; i++) {
+		tiny4koled_write_async(bytes[i]);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlockP_async(const uint8_t *bytes, uint16_t count) {
+	if (count == 0) return 0;
+	DCAsyncTransfer &t = tiny4koled_async_transfer(TINY4KOLED_ASYNC_PROGMEM);
+	t.block.bytes = bytes;
+	t.block.count = count;
+	tiny4koled_async_queue();
+	return count;
+}
+
+// Queues a function to be called once everything queued before it has been sent.
+// It is called from the interrupt, so must be short.
+static void tiny4koled_async_callback(void (*callback)(void)) {
+	tiny4koled_async_end_filling();
+	if (!tiny4koled_async.running && tiny4koled_async.tail == tiny4koled_async.head) {
+		callback();
+		return;
+	}
+	tiny4koled_async_transfer(TINY4KOLED_ASYNC_CALLBACK).callback = callback;
+	tiny4koled_async_queue();
+}
+
+static void tiny4koled_async_wait_idle(void) {
+	tiny4koled_async_end_filling();
+	while (tiny4koled_async.running) {
+		TINY4KOLED_ASYNC_WAIT();
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+#ifndef TINY4KOLED_ASYNC_ENGINE
+#if !defined(TWCR)
+#error Tiny4kOLED_async.h drives the TWI peripheral, which this part does not have. There is no USI engine. Define TINY4KOLED_ASYNC_ENGINE to supply another engine.
+#endif
+
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+static void tiny4koled_async_engine_begin(void) {
+	// Enable the internal pullups, as the Wire library does.
+	digitalWrite(SDA, HIGH);
+	digitalWrite(SCL, HIGH);
+	TWSR = 0; // a prescaler of 1
+	TWBR = ((F_CPU / TINY4KOLED_ASYNC_CLOCK) - 16) / 2;
+	TWCR = _BV(TWEN);
+}
+
+// Sends a STOP, followed by a START when another transaction is waiting.
+static void tiny4koled_async_twi_stop(void) {
+	if (tiny4koled_async_pending()) {
+		TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE) | _BV(TWSTO) | _BV(TWSTA);
+	} else {
+		tiny4koled_async.running = false;
+		TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+	}
+}
+
+static void tiny4koled_async_engine_kick(void) {
+	tiny4koled_async.running = true;
+	if (TWCR & _BV(TWINT)) {
+		// The engine stopped part way through a transaction, holding the bus.
+		TWCR = _BV(TWEN) | _BV(TWIE);
+		return;
+	}
+	while (TWCR & _BV(TWSTO));
+	if (tiny4koled_async_pending()) {
+		TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE) | _BV(TWSTA);
+	} else {
+		tiny4koled_async.running = false;
+	}
+}
+
+ISR(TWI_vect) {
+	uint8_t byte = 0;
+	uint8_t event;
+	switch (TW_STATUS) {
+		case TW_START:
+		case TW_REP_START:
+		case TW_MT_SLA_ACK:
+		case TW_MT_DATA_ACK:
+			event = tiny4koled_async_next(&byte);
+			break;
+		default:
+			// Not acknowledged, or arbitration was lost. The rest of the transaction is dropped.
+			tiny4koled_async.nacks++;
+			tiny4koled_async.discarding = true;
+			event = TINY4KOLED_ASYNC_STOP;
+			break;
+	}
+	switch (event) {
+		case TINY4KOLED_ASYNC_START:
+			TWDR = byte << 1;
+			TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+			break;
+		case TINY4KOLED_ASYNC_BYTE:
+			TWDR = byte;
+			TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+			break;
+		case TINY4KOLED_ASYNC_NONE:
+			// Hold the bus, with the interrupt disabled, until more of the transaction is queued.
+			TWCR = _BV(TWEN);
+			break;
+		default:
+			tiny4koled_async_twi_stop();
+			break;
+	}
+}
+#endif
+
+static void tiny4koled_begin_async(void) {
+	tiny4koled_async_engine_begin();
+#ifndef TINY4KOLED_QUICK_BEGIN
+	uint8_t nacks;
+	do {
+		nacks = tiny4koled_async.nacks;
+		tiny4koled_beginTransmission_async();
+		tiny4koled_endTransmission_async();
+		tiny4koled_async_wait_idle();
+		if (tiny4koled_async.nacks == nacks) break;
+		delay(10);
+	} while (true);
+#endif
+}
+
+#ifndef TINY4KOLED_NO_PRINT
+#define TINY4KOLED_ASYNC_DEVICE SSD1306PrintDevice
+#else
+#define TINY4KOLED_ASYNC_DEVICE SSD1306Device
+#endif
+
+class SSD1306AsyncDevice: public TINY4KOLED_ASYNC_DEVICE {
+	public:
+		SSD1306AsyncDevice(void) :
+			TINY4KOLED_ASYNC_DEVICE(&tiny4koled_begin_async, &tiny4koled_beginTransmission_async, &tiny4koled_write_async, &tiny4koled_endTransmission_async, &tiny4koled_repeat_async, &tiny4koled_writeBlock_async, &tiny4koled_writeBlockP_async) {};
+		// True while queued transfers are still being sent.
+		bool isBusy(void) {
+			return tiny4koled_async.running;
+		};
+		void waitIdle(void) {
+			tiny4koled_async_wait_idle();
+		};
+		// The callback is called from the interrupt, once everything drawn before this call has been sent.
+		void onComplete(void (*callback)(void)) {
+			tiny4koled_async_callback(callback);
+		};
+};
+
+SSD1306AsyncDevice oled;
+
+#endif
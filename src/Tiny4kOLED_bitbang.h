@@ -63,10 +63,31 @@ static bool tiny4koled_beginTransmission_bitbang(void) {
 	PORTB |= (1 << PB0);//digitalWrite(SDA, HIGH);
 	PORTB &= ~(1 << PB0);//digitalWrite(SDA, LOW);
 	PORTB &= ~(1 << PB2);//digitalWrite(SCL, LOW);
-	datacute_write_bitbang(SSD1306<<1);
+	datacute_write_bitbang(TINY4KOLED_ADDRESS<<1);
 	return 0;
 }
 
+static uint16_t tiny4koled_repeat_bitbang(uint8_t byte, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		datacute_write_bitbang(byte);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlock_bitbang(const uint8_t *bytes, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		datacute_write_bitbang(bytes[i]);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlockP_bitbang(const uint8_t *bytes, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		datacute_write_bitbang(pgm_read_byte(&bytes[i]));
+	}
+	return count;
+}
+
 static void tiny4koled_begin_bitbang(void) {
 	pinMode(SCL, OUTPUT);
 	pinMode(SDA, OUTPUT);
@@ -74,9 +95,9 @@ static void tiny4koled_begin_bitbang(void) {
 
 
 #ifndef TINY4KOLED_NO_PRINT
-SSD1306PrintDevice oled(&tiny4koled_begin_bitbang, &tiny4koled_beginTransmission_bitbang, &datacute_write_bitbang, &datacute_endTransmission_bitbang);
+SSD1306PrintDevice oled(&tiny4koled_begin_bitbang, &tiny4koled_beginTransmission_bitbang, &datacute_write_bitbang, &datacute_endTransmission_bitbang, &tiny4koled_repeat_bitbang, &tiny4koled_writeBlock_bitbang, &tiny4koled_writeBlockP_bitbang);
 #else
-SSD1306Device oled(&tiny4koled_begin_bitbang, &tiny4koled_beginTransmission_bitbang, &datacute_write_bitbang, &datacute_endTransmission_bitbang);
+SSD1306Device oled(&tiny4koled_begin_bitbang, &tiny4koled_beginTransmission_bitbang, &datacute_write_bitbang, &datacute_endTransmission_bitbang, &tiny4koled_repeat_bitbang, &tiny4koled_writeBlock_bitbang, &tiny4koled_writeBlockP_bitbang);
 #endif
 
 #endif
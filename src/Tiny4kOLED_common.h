@@ -11,6 +11,15 @@
 #ifndef TINY4KOLEDCOMMON_H
 #define TINY4KOLEDCOMMON_H
 
+// The tables of a font whose glyphs are Huffman coded. See extras/fontcompress.py
+// Each glyph is coded column by column, with each column's pages from the top, so that it can be decoded as it is sent.
+typedef struct DCFontCompression {
+	uint8_t *symbols;      // the distinct bytes of the glyphs, in canonical code order
+	uint8_t *lengthCounts; // the number of codes of each length, from 1 bit to maxLength bits
+	uint8_t maxLength;
+	uint16_t *checkpoints; // the bit offset of every 16th character's glyph
+} DCFontCompression;
+
 typedef struct DCfont {
 	uint8_t *bitmap;      // character bitmaps data
 	uint8_t width;        // character width in pixels
@@ -20,6 +29,11 @@ typedef struct DCfont {
 	uint16_t *widths16s;
 	uint8_t *widths;
 	uint8_t spacing;      // number of blank columns of pixels to write between characters
+	// Optional, for proportional fonts: the offset of each character's bitmap data, in bytes.
+	// This avoids summing the widths of the preceding characters. See extras/fontoffsets.py
+	uint16_t *offsets;
+	// Optional: when set, bitmap is the Huffman coded glyph data, decoded using these tables.
+	const DCFontCompression *compression;
 } DCfont;
 
 // Unicode Blocks are NOT bits 8 to 15 of the codepoint, but this library pretends that they are.
@@ -29,10 +43,21 @@ typedef struct DCUnicodeFontRef {
 	const DCfont *font; // font glyphs within this unicode block
 } DCUnicodeFontRef;
 
+// An entry of an optional index of a unicode font's character ranges, held in PROGMEM.
+// The entries are sorted by plane, block and first, and the ranges must not overlap.
+typedef struct DCUnicodeFontIndex {
+	uint8_t unicode_plane;
+	uint8_t unicode_block;
+	uint8_t first, last;  // the range of the lower byte of the codepoint
+	uint8_t font;         // the number of the font reference covering the range
+} DCUnicodeFontIndex;
+
 typedef struct DCUnicodeFont {
 	uint8_t space_width; // the width of the space character, which does not need to be included in the font glyphs.
 	uint8_t num_fonts; // number of character ranges in this unicode font
 	const DCUnicodeFontRef * fonts; // the font references
+	// Optional, an index with an entry for each font reference, so that the font for a character is found by a binary search.
+	const DCUnicodeFontIndex * index;
 } DCUnicodeFont;
 
 union DCUnicodeCodepoint {
@@ -45,6 +70,49 @@ union DCUnicodeCodepoint {
     } unicode;
 };
 
+// Counts of what has been sent to the transport, only collected when TINY4KOLED_STATS is defined.
+typedef struct DCTransferStats {
+	uint32_t bytes;        // all bytes written, including control bytes
+	uint32_t transactions; // START ... STOP pairs
+	uint32_t commandBytes;
+	uint32_t dataBytes;
+} DCTransferStats;
+
+// A copy of some or all of the display's pages, held in RAM. See SSD1306Device::setFrameBuffer.
+// Initialise the first three members, e.g. DCFrameBuffer frameBuffer = { buffer, 0, 8 };
+typedef struct DCFrameBuffer {
+	uint8_t *buffer;      // 128 bytes for each page
+	uint8_t firstPage;    // the first page held in the buffer
+	uint8_t pages;        // the number of pages held, up to 8
+	// The remaining members are maintained by the library
+	uint8_t firstColumn, columns; // the range of columns held in each page
+	bool composite;       // true when drawing is ORed into the buffer, rather than replacing it
+	uint8_t dirtyStart[8], dirtyEnd[8]; // the columns of each page changed since the last flush
+	uint8_t addressingMode, columnStart, columnEnd, pageStart, pageEnd;
+	uint8_t column, page; // where the display's address pointer would be
+	bool controlExpected;
+	uint8_t control;
+	uint8_t command[7];
+	uint8_t commandLength, commandExpected;
+} DCFrameBuffer;
+
+// The position of a line of text scrolled a column at a time. See SSD1306Device::startMarquee.
+// The members are maintained by the library.
+typedef struct DCMarquee {
+	const char *text;     // the start of the text, returned to after its end
+	const char *next;     // the next byte of the text to be read
+	bool progmem;         // true when the text is held in PROGMEM
+	bool utf8;            // true when the text is decoded as UTF-8 using the unicode font
+	uint8_t x, y;         // the top left of the scrolled region
+	uint8_t width, height; // the width of the region in columns, and its height in pages
+	const DCfont *font;   // the font of the character being drawn
+	uint8_t spacing;      // the blank columns after each character, which change with the font when decoding UTF-8
+	uint8_t c;            // the character being drawn
+	uint8_t glyphColumns; // the columns of the character's glyph, followed by blank columns
+	uint8_t columns;      // the glyph and spacing columns of the character
+	uint8_t column;       // the next column of the character to draw
+} DCMarquee;
+
 // included fonts, The space isn't used unless it is needed
 #include "font6x8.h"
 #include "font6x8p.h"
@@ -62,6 +130,15 @@ union DCUnicodeCodepoint {
 #define SSD1306		0x3C	// Slave address
 #endif
 
+// When TINY4KOLED_MULTIPLE_DISPLAYS is defined for the whole build, each SSD1306Device has its own state and address,
+// and the transports address the display being drawn to.
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+extern uint8_t tiny4koled_address;
+#define TINY4KOLED_ADDRESS tiny4koled_address
+#else
+#define TINY4KOLED_ADDRESS SSD1306
+#endif
+
 #define SSD1306_VOLTAGE_6_0 0x15
 #define SSD1306_VOLTAGE_7_5 0x14
 #define SSD1306_VOLTAGE_8_5 0x94
@@ -89,26 +166,58 @@ union DCUnicodeCodepoint {
 
 // ----------------------------------------------------------------------------
 
+typedef struct SSD1306Transport {
+	bool (*beginTransmission)(void);
+	bool (*write)(uint8_t byte);
+	uint8_t (*endTransmission)(void);
+	uint16_t (*repeat)(uint8_t byte, uint16_t count);
+	uint16_t (*writeBlock)(const uint8_t *bytes, uint16_t count);
+	uint16_t (*writeBlockP)(const uint8_t *bytes, uint16_t count);
+	// Transactions are split before they exceed the number of bytes the transport can buffer.
+	uint16_t maxPayload; // 0 when there is no limit
+} SSD1306Transport;
+
 class SSD1306Device {
 
 	public:
-		SSD1306Device(void (*wireBeginFunc)(void), bool (*wireBeginTransmissionFunc)(void), bool (*wireWriteFunc)(uint8_t byte), uint8_t (*wireEndTransmissionFunc)(void));
+		// The optional wireRepeatFunc writes up to count copies of a byte, and wireWriteBlockFunc and wireWriteBlockPFunc
+		// write up to count bytes from RAM and PROGMEM respectively. Each returns the number of bytes written.
+		// wireMaxPayloadBytes is the number of bytes the transport can buffer in one transaction (0 for no limit).
+		SSD1306Device(void (*wireBeginFunc)(void), bool (*wireBeginTransmissionFunc)(void), bool (*wireWriteFunc)(uint8_t byte), uint8_t (*wireEndTransmissionFunc)(void), uint16_t (*wireRepeatFunc)(uint8_t byte, uint16_t count) = 0, uint16_t (*wireWriteBlockFunc)(const uint8_t *bytes, uint16_t count) = 0, uint16_t (*wireWriteBlockPFunc)(const uint8_t *bytes, uint16_t count) = 0, uint16_t wireMaxPayloadBytes = 0);
 
 		void begin(void);
 		void begin(uint8_t init_sequence_length, const uint8_t init_sequence []);
+#ifndef TINY4KOLED_WIDTH
 		void begin(uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []);
 		void begin(uint8_t xOffset, uint8_t yOffset, uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []);
+#else
+		// The geometry is fixed by TINY4KOLED_WIDTH and TINY4KOLED_HEIGHT, so the methods that would change it are deleted,
+		// making a call to them a compile error, rather than being silently ignored. Use begin(init_sequence_length, init_sequence).
+		void begin(uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) = delete;
+		void begin(uint8_t xOffset, uint8_t yOffset, uint8_t width, uint8_t height, uint8_t init_sequence_length, const uint8_t init_sequence []) = delete;
+#endif
 		void switchRenderFrame(void);
 		void switchDisplayFrame(void);
 		void switchFrame(void);
 		uint8_t currentRenderFrame(void);
 		uint8_t currentDisplayFrame(void);
 		void setFont(const DCfont *font);
-		void setUnicodeFont(const DCUnicodeFont *unicode_font);
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
 		void setFontX2(const DCfont *font);
-		void setUnicodeFontX2(const DCUnicodeFont *unicode_font);
 		void setFontX2Smooth(const DCfont *font);
+		// Draws the font scale times larger, where scale is 1 to 4.
+		// Characters that would be taller than the display are drawn at the largest scale that fits, e.g. 2 for a 16 pixel high font on a 32 pixel high display.
+		void setFontScaled(const DCfont *font, uint8_t scale);
+		void setFontScale(uint8_t scale);
+#endif
+#ifndef TINY4KOLED_NO_UNICODE
+		void setUnicodeFont(const DCUnicodeFont *unicode_font);
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+		void setUnicodeFontX2(const DCUnicodeFont *unicode_font);
 		void setUnicodeFontX2Smooth(const DCUnicodeFont *unicode_font);
+		void setUnicodeFontScaled(const DCUnicodeFont *unicode_font, uint8_t scale);
+#endif
+#endif
 		// If your code does not call oled.print then you can save space by calling setFontOnly instead of the above.
 		void setFontOnly(const DCfont *font);
 		void setSpacing(uint8_t spacing);
@@ -121,6 +230,8 @@ class SSD1306Device {
 		uint8_t getCursorX();
 		uint8_t getCursorY();
 		void newLine();
+		// In console mode, new lines past the bottom of the display scroll it up, using the display start line.
+		void setConsoleMode(bool enable);
 		void fill(uint8_t fill);
 		void fillToEOL(uint8_t fill);
 		void fillToEOP(uint8_t fill);
@@ -129,19 +240,50 @@ class SSD1306Device {
 		void clearToEOL(void);
 		void clearToEOP(void);
 		void bitmap(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t bitmap[]);
+		// Draws a bitmap made by extras/bitmapcompress.py. When transparent, long runs of zeros are skipped, leaving what was there.
+		void bitmapCompressed(uint8_t x0, uint8_t y0, const uint8_t bitmap[], bool transparent = false);
 		void startData(void);
 		void sendData(const uint8_t data);
 		void repeatData(uint8_t data, uint8_t length);
 		void clearData(uint8_t length);
 		void endData(void);
+#ifndef TINY4KOLED_WIDTH
 		void setPages(uint8_t pages);
 		void setWidth(uint8_t width);
 		void setHeight(uint8_t height);
 		void setOffset(uint8_t xOffset, uint8_t yOffset);
+#else
+		void setPages(uint8_t pages) = delete;
+		void setWidth(uint8_t width) = delete;
+		void setHeight(uint8_t height) = delete;
+		void setOffset(uint8_t xOffset, uint8_t yOffset) = delete;
+#endif
 		void setRotation(uint8_t rotation);
 		void clipText(uint16_t startPixel, uint8_t width, DATACUTE_F_MACRO_T *text);
 		void clipTextP(uint16_t startPixel, uint8_t width, DATACUTE_F_MACRO_T *text);
+		// Draws a line of text at the cursor in one data transaction, clipped to the display's width, or to width pixels.
+		void drawString(const char *text, uint8_t width = 0xFF);
+		void drawString(DATACUTE_F_MACRO_T *text, uint8_t width = 0xFF);
+		void startMarquee(DCMarquee *marquee, const char *text, uint8_t width);
+		void startMarquee(DCMarquee *marquee, DATACUTE_F_MACRO_T *text, uint8_t width);
+		void scrollMarquee(DCMarquee *marquee);
+		void drawMarquee(DCMarquee *marquee);
 		void invertOutput(bool enable);
+		// While a frame buffer is set, drawing updates the buffer, and flush sends the changes to the display.
+		void setFrameBuffer(DCFrameBuffer *frameBuffer);
+		void flush(void);
+		bool flushStep(void);
+		bool service(uint16_t budget);
+		// Draws the display a tile at a time, for when a whole frame buffer will not fit in RAM.
+		void drawTiles(uint8_t *tile, uint8_t tileWidth, void (*drawFunc)(uint8_t x, uint8_t page, uint8_t *tile));
+#ifdef TINY4KOLED_STATS
+		DCTransferStats getStats(void);
+		void resetStats(void);
+#endif
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+		// The I2C address used by the transport, SSD1306 (0x3C) by default.
+		void setAddress(uint8_t address);
+#endif
 
 		// 1. Fundamental Command Table
 
@@ -210,16 +352,64 @@ class SSD1306Device {
 		void RenderUnicodeSpace(void);
 		bool SelectUnicodeBlock(void);
 		void renderOriginalSize(uint8_t c);
-		void renderDoubleSize(uint8_t c);
+		void renderScaled(uint8_t c);
+		void scrollConsole(uint8_t pages);
 		void renderDoubleSizeSmooth(uint8_t c);
 		void sendDoubleBits(uint32_t doubleBits);
+		void renderString(const char *text, bool progmem, uint8_t width);
+		void beginMarquee(DCMarquee *marquee, const char *text, bool progmem, uint8_t width);
+		void readMarqueeCharacter(DCMarquee *marquee);
+		void sendMarqueeColumns(DCMarquee *marquee, uint8_t count);
+		void sendCharacterColumns(uint8_t c, uint8_t skip, uint8_t columns);
+#ifdef TINY4KOLED_MULTIPLE_DISPLAYS
+		void select(void);
+
+		// The state of this display, held here while another display is selected.
+		// The state of the selected display is held in the statics in Tiny4kOLED.cpp, which have the same names.
+		struct SavedState {
+			uint8_t tiny4koled_address = SSD1306;
+			void (*wireBeginFn)(void) = 0;
+			SSD1306Transport wire = {};
+			SSD1306Transport otherTransport = {};
+			bool capturing = false;
+			DCFrameBuffer *frameBuffer = 0;
+			uint8_t oledOffsetX = 0, oledOffsetY = 0;
+			uint8_t oledWidth = 128;
+			uint8_t oledPages = 4;
+			const DCUnicodeFont *oledUnicodeFont = 0;
+			uint8_t unicodeFontNum = 0;
+			uint8_t asciiFontNum = 0xFF;
+			const DCfont *oledFont = 0;
+			uint8_t oledX = 0, oledY = 0;
+			uint8_t renderingFrame = 0xB0, drawingFrame = 0x40;
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+			uint8_t fontScale = 1;
+#endif
+			uint8_t characterSpacing = 0;
+			DCUnicodeCodepoint unicodeCodepoint = { 0 };
+			uint8_t utf8Continuation = 0;
+#ifndef TINY4KOLED_NO_UNICODE
+			void (SSD1306Device::* decodeFn)(uint8_t c) = 0;
+#endif
+#ifndef TINY4KOLED_ONLY_ORIGINAL_SIZE
+			void (SSD1306Device::* renderFn)(uint8_t c) = 0;
+#endif
+			uint8_t (*combineFn)(uint8_t x, uint8_t y, uint8_t b) = 0;
+			uint8_t writesSinceSetCursor = 0;
+			uint8_t windowPages = 0, windowTop = 0;
+			bool pointerAtCursor = false;
+			bool cursorPending = false;
+			bool consoleMode = false;
+			uint8_t consoleScroll = 0;
+		} savedState;
+#endif
 
 };
 
 class SSD1306PrintDevice: public Print, public SSD1306Device {
 	public:
-		SSD1306PrintDevice(void (*wireBeginFunc)(void), bool (*wireBeginTransmissionFunc)(void), bool (*wireWriteFunc)(uint8_t byte), uint8_t (*wireEndTransmissionFunc)(void)) : 
-			SSD1306Device(wireBeginFunc, wireBeginTransmissionFunc, wireWriteFunc, wireEndTransmissionFunc) {};
+		SSD1306PrintDevice(void (*wireBeginFunc)(void), bool (*wireBeginTransmissionFunc)(void), bool (*wireWriteFunc)(uint8_t byte), uint8_t (*wireEndTransmissionFunc)(void), uint16_t (*wireRepeatFunc)(uint8_t byte, uint16_t count) = 0, uint16_t (*wireWriteBlockFunc)(const uint8_t *bytes, uint16_t count) = 0, uint16_t (*wireWriteBlockPFunc)(const uint8_t *bytes, uint16_t count) = 0, uint16_t wireMaxPayloadBytes = 0) : 
+			SSD1306Device(wireBeginFunc, wireBeginTransmissionFunc, wireWriteFunc, wireEndTransmissionFunc, wireRepeatFunc, wireWriteBlockFunc, wireWriteBlockPFunc, wireMaxPayloadBytes) {};
 		size_t write(byte c) {
 			return SSD1306Device::write(c);
 		};
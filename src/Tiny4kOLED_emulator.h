@@ -0,0 +1,344 @@
+/*
+ * Tiny4kOLED - Drivers for SSD1306 controlled dot matrix OLED/PLED 128x32 displays
+ *
+ * Based on ssd1306xled, re-written and extended by Stephen Denne
+ * from 2017-04-25 at https://github.com/datacute/Tiny4kOLED
+ *
+ * This file adds a host side transport, for desktop builds of the library.
+ * Instead of an I2C bus, the bytes are fed into a software model of the SSD1306,
+ * which keeps its own copy of the GDDRAM, and counts the bytes, transactions,
+ * and the time they would have taken on the wire.
+ * The Arduino.h and avr/pgmspace.h headers for the host build are in extras/host.
+ */
+#ifndef TINY4KOLED_EMULATOR_H
+#define TINY4KOLED_EMULATOR_H
+
+#include <stdio.h>
+#include <string.h>
+#include "Tiny4kOLED_common.h"
+
+// The Wire library's buffer size. Set to 0 to accept transactions of any length.
+#ifndef TINY4KOLED_EMULATOR_BUFFER_LENGTH
+#define TINY4KOLED_EMULATOR_BUFFER_LENGTH 32
+#endif
+
+#ifndef TINY4KOLED_EMULATOR_CLOCK
+#define TINY4KOLED_EMULATOR_CLOCK 100000
+#endif
+
+typedef struct SSD1306Emulator {
+	// Controller state
+	uint8_t ram[8][128];      // GDDRAM, 8 pages of 128 columns
+	uint8_t addressingMode;   // 0=Horizontal, 1=Vertical, 2=Page
+	uint8_t columnStart, columnEnd;
+	uint8_t pageStart, pageEnd;
+	uint8_t column, page;     // the GDDRAM address pointer
+	uint8_t startLine;
+	uint8_t displayOffset;
+	uint8_t multiplex;        // number of rows displayed
+	uint8_t contrast;
+	uint8_t displayOn, inverse, zoom, scrolling;
+
+	// Bus accounting
+	uint16_t bufferLength;    // 0 = unlimited
+	uint32_t clock;           // in Hz, used to estimate the wire time
+	uint32_t bytes;           // every byte on the bus, including address and control bytes
+	uint32_t transactions;    // START ... STOP pairs
+	uint32_t commandBytes;
+	uint32_t dataBytes;
+
+	// Transmission decoder state
+	uint16_t buffered;
+	uint8_t controlExpected;
+	uint8_t control;
+	uint8_t command[8];
+	uint8_t commandLength;
+	uint8_t commandExpected;
+} SSD1306Emulator;
+
+static SSD1306Emulator tiny4koled_emulator;
+
+// Number of argument bytes following each multi-byte command
+static uint8_t tiny4koled_emulator_argument_count(uint8_t command) {
+	switch (command) {
+		case 0x20: case 0x23: case 0x81: case 0x8D: case 0xA8: case 0xAD:
+		case 0xD3: case 0xD5: case 0xD6: case 0xD9: case 0xDA: case 0xDB:
+			return 1;
+		case 0x21: case 0x22: case 0xA3:
+			return 2;
+		case 0x29: case 0x2A:
+			return 5;
+		case 0x26: case 0x27: case 0x2C: case 0x2D:
+			return 6;
+	}
+	return 0;
+}
+
+// Reset the controller to its power on state. The GDDRAM and counters are left alone.
+static void tiny4koled_emulator_power_on(void) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	e.addressingMode = 2;
+	e.columnStart = 0;
+	e.columnEnd = 127;
+	e.pageStart = 0;
+	e.pageEnd = 7;
+	e.column = 0;
+	e.page = 0;
+	e.startLine = 0;
+	e.displayOffset = 0;
+	e.multiplex = 64;
+	e.contrast = 0x7F;
+	e.displayOn = 0;
+	e.inverse = 0;
+	e.zoom = 0;
+	e.scrolling = 0;
+	if (e.clock == 0) {
+		e.bufferLength = TINY4KOLED_EMULATOR_BUFFER_LENGTH;
+		e.clock = TINY4KOLED_EMULATOR_CLOCK;
+	}
+}
+
+static void tiny4koled_emulator_reset_counters(void) __attribute__((unused));
+static void tiny4koled_emulator_reset_counters(void) {
+	tiny4koled_emulator.bytes = 0;
+	tiny4koled_emulator.transactions = 0;
+	tiny4koled_emulator.commandBytes = 0;
+	tiny4koled_emulator.dataBytes = 0;
+}
+
+// Each byte takes 9 clocks (8 bits and an ack), and each START and STOP one more.
+static uint32_t tiny4koled_emulator_wire_micros(void) __attribute__((unused));
+static uint32_t tiny4koled_emulator_wire_micros(void) {
+	uint64_t clocks = (uint64_t)tiny4koled_emulator.bytes * 9 + (uint64_t)tiny4koled_emulator.transactions * 2;
+	return (uint32_t)(clocks * 1000000 / tiny4koled_emulator.clock);
+}
+
+// Shifts the content of a region one column left or right, as the controller does with 0x2C and 0x2D,
+// but at once, rather than as the display next refreshes. The column shifted out comes back in at the other side.
+static void tiny4koled_emulator_scroll_content(bool left) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	uint8_t startColumn = e.command[5] & 0x7F, endColumn = e.command[6] & 0x7F;
+	if (endColumn <= startColumn) return;
+	for (uint8_t page = e.command[2] & 0x07; page <= (e.command[4] & 0x07); page++) {
+		uint8_t *row = e.ram[page];
+		if (left) {
+			uint8_t first = row[startColumn];
+			memmove(&row[startColumn], &row[startColumn + 1], endColumn - startColumn);
+			row[endColumn] = first;
+		} else {
+			uint8_t last = row[endColumn];
+			memmove(&row[startColumn + 1], &row[startColumn], endColumn - startColumn);
+			row[startColumn] = last;
+		}
+	}
+}
+
+static void tiny4koled_emulator_execute_command(void) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	uint8_t c = e.command[0];
+	if (c <= 0x0F) {
+		e.column = (e.column & 0x70) | c;
+	} else if (c <= 0x17) {
+		e.column = (e.column & 0x0F) | ((c & 0x07) << 4);
+	} else if (c >= 0x40 && c <= 0x7F) {
+		e.startLine = c & 0x3F;
+	} else if (c >= 0xB0 && c <= 0xB7) {
+		e.page = c & 0x07;
+	} else {
+		switch (c) {
+			case 0x20:
+				if ((e.command[1] & 0x03) != 0x03) e.addressingMode = e.command[1] & 0x03;
+				break;
+			case 0x21:
+				e.columnStart = e.command[1] & 0x7F;
+				e.columnEnd = e.command[2] & 0x7F;
+				e.column = e.columnStart;
+				break;
+			case 0x22:
+				e.pageStart = e.command[1] & 0x07;
+				e.pageEnd = e.command[2] & 0x07;
+				e.page = e.pageStart;
+				break;
+			case 0x2C: tiny4koled_emulator_scroll_content(false); break;
+			case 0x2D: tiny4koled_emulator_scroll_content(true); break;
+			case 0x2E: e.scrolling = 0; break;
+			case 0x2F: e.scrolling = 1; break;
+			case 0x81: e.contrast = e.command[1]; break;
+			case 0xA6: e.inverse = 0; break;
+			case 0xA7: e.inverse = 1; break;
+			case 0xA8: e.multiplex = (e.command[1] & 0x3F) + 1; break;
+			case 0xAE: e.displayOn = 0; break;
+			case 0xAF: e.displayOn = 1; break;
+			case 0xD3: e.displayOffset = e.command[1] & 0x3F; break;
+			case 0xD6: e.zoom = e.command[1] & 0x01; break;
+		}
+	}
+}
+
+static void tiny4koled_emulator_command_byte(uint8_t byte) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	e.commandBytes++;
+	if (e.commandLength == 0) {
+		e.commandExpected = tiny4koled_emulator_argument_count(byte);
+	}
+	e.command[e.commandLength++] = byte;
+	if (e.commandLength > e.commandExpected) {
+		tiny4koled_emulator_execute_command();
+		e.commandLength = 0;
+	}
+}
+
+static void tiny4koled_emulator_data_byte(uint8_t byte) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	e.dataBytes++;
+	e.ram[e.page][e.column] = byte;
+	switch (e.addressingMode) {
+		case 0:
+			if (e.column >= e.columnEnd) {
+				e.column = e.columnStart;
+				e.page = (e.page >= e.pageEnd) ? e.pageStart : e.page + 1;
+			} else {
+				e.column++;
+			}
+			break;
+		case 1:
+			if (e.page >= e.pageEnd) {
+				e.page = e.pageStart;
+				e.column = (e.column >= e.columnEnd) ? e.columnStart : e.column + 1;
+			} else {
+				e.page++;
+			}
+			break;
+		default:
+			e.column = (e.column >= e.columnEnd) ? e.columnStart : e.column + 1;
+			break;
+	}
+}
+
+// Returns the state (0 or 1) of a pixel in GDDRAM, x from 0 to 127, y from 0 to 63.
+static uint8_t tiny4koled_emulator_pixel(uint8_t x, uint8_t y) __attribute__((unused));
+static uint8_t tiny4koled_emulator_pixel(uint8_t x, uint8_t y) {
+	return (tiny4koled_emulator.ram[(y >> 3) & 0x07][x & 0x7F] >> (y & 0x07)) & 0x01;
+}
+
+// Prints the rows currently being displayed, as selected by the start line, display offset, and multiplex ratio.
+static void tiny4koled_emulator_dump(FILE *out) __attribute__((unused));
+static void tiny4koled_emulator_dump(FILE *out) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	for (uint8_t row = 0; row < e.multiplex; row++) {
+		uint8_t y = (row + e.startLine + e.displayOffset) & 0x3F;
+		for (uint8_t x = 0; x < 128; x++) {
+			fputc(tiny4koled_emulator_pixel(x, y) ? '#' : '.', out);
+		}
+		fputc('\n', out);
+	}
+}
+
+// Feeds the emulator as a display wired for SPI, where the D/C# pin selects commands or data, instead of a control byte.
+// Each selection of the chip is counted as a transaction.
+static void tiny4koled_emulator_spi_select(void) __attribute__((unused));
+static void tiny4koled_emulator_spi_select(void) {
+	tiny4koled_emulator.transactions++;
+	tiny4koled_emulator.commandLength = 0;
+}
+
+static void tiny4koled_emulator_spi_transfer(uint8_t byte, bool data) __attribute__((unused));
+static void tiny4koled_emulator_spi_transfer(uint8_t byte, bool data) {
+	tiny4koled_emulator.bytes++;
+	if (data) {
+		tiny4koled_emulator_data_byte(byte);
+	} else {
+		tiny4koled_emulator_command_byte(byte);
+	}
+}
+
+#ifndef DATACUTE_I2C_EMULATOR
+#define DATACUTE_I2C_EMULATOR
+
+static bool datacute_write_emulator(uint8_t byte) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	if (e.bufferLength != 0 && e.buffered >= e.bufferLength) {
+		return false;
+	}
+	e.buffered++;
+	e.bytes++;
+	if (e.controlExpected) {
+		// Co=0 means the rest of the transaction is of the type selected by D/C#
+		// Co=1 means only the next byte is, and will be followed by another control byte.
+		e.control = byte;
+		e.controlExpected = 0;
+		return true;
+	}
+	if (e.control & 0x40) {
+		tiny4koled_emulator_data_byte(byte);
+	} else {
+		tiny4koled_emulator_command_byte(byte);
+	}
+	if (e.control & 0x80) {
+		e.controlExpected = 1;
+	}
+	return true;
+}
+
+static uint8_t datacute_read_emulator(void) __attribute__((unused));
+static uint8_t datacute_read_emulator(void) {
+	return 0;
+}
+
+static void datacute_end_read_emulator(void) __attribute__((unused));
+static void datacute_end_read_emulator(void) {}
+
+static uint8_t datacute_endTransmission_emulator(void) __attribute__((unused));
+static uint8_t datacute_endTransmission_emulator(void) {
+	return 0;
+}
+
+#endif
+
+static bool tiny4koled_beginTransmission_emulator(void) __attribute__((unused));
+static bool tiny4koled_beginTransmission_emulator(void) {
+	SSD1306Emulator &e = tiny4koled_emulator;
+	e.transactions++;
+	e.bytes++; // the address byte
+	e.buffered = 0;
+	e.controlExpected = 1;
+	e.commandLength = 0;
+	return true;
+}
+
+// Behaves like a buffered transport, stopping when the buffer is full.
+static uint16_t tiny4koled_repeat_emulator(uint8_t byte, uint16_t count) __attribute__((unused));
+static uint16_t tiny4koled_repeat_emulator(uint8_t byte, uint16_t count) {
+	uint16_t sent = 0;
+	while (sent < count && datacute_write_emulator(byte)) sent++;
+	return sent;
+}
+
+static uint16_t tiny4koled_writeBlock_emulator(const uint8_t *bytes, uint16_t count) __attribute__((unused));
+static uint16_t tiny4koled_writeBlock_emulator(const uint8_t *bytes, uint16_t count) {
+	uint16_t sent = 0;
+	while (sent < count && datacute_write_emulator(bytes[sent])) sent++;
+	return sent;
+}
+
+static uint16_t tiny4koled_writeBlockP_emulator(const uint8_t *bytes, uint16_t count) __attribute__((unused));
+static uint16_t tiny4koled_writeBlockP_emulator(const uint8_t *bytes, uint16_t count) {
+	uint16_t sent = 0;
+	while (sent < count && datacute_write_emulator(pgm_read_byte(&bytes[sent]))) sent++;
+	return sent;
+}
+
+static void tiny4koled_begin_emulator(void) {
+	tiny4koled_emulator_power_on();
+}
+
+// Defining TINY4KOLED_EMULATOR_NO_DEVICE leaves out the oled device, so that the emulator can be used as the bus of another transport.
+#ifndef TINY4KOLED_EMULATOR_NO_DEVICE
+#ifndef TINY4KOLED_NO_PRINT
+SSD1306PrintDevice oled(&tiny4koled_begin_emulator, &tiny4koled_beginTransmission_emulator, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, TINY4KOLED_EMULATOR_BUFFER_LENGTH);
+#else
+SSD1306Device oled(&tiny4koled_begin_emulator, &tiny4koled_beginTransmission_emulator, &datacute_write_emulator, &datacute_endTransmission_emulator, &tiny4koled_repeat_emulator, &tiny4koled_writeBlock_emulator, &tiny4koled_writeBlockP_emulator, TINY4KOLED_EMULATOR_BUFFER_LENGTH);
+#endif
+#endif
+
+#endif
@@ -38,7 +38,28 @@ static uint8_t datacute_endTransmission_tinyi2c(void) {
 #endif
 
 static bool tiny4koled_beginTransmission_tinyi2c(void) {
-	return TinyI2C.start(SSD1306, 0);
+	return TinyI2C.start(TINY4KOLED_ADDRESS, 0);
+}
+
+static uint16_t tiny4koled_repeat_tinyi2c(uint8_t byte, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		TinyI2C.write(byte);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlock_tinyi2c(const uint8_t *bytes, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		TinyI2C.write(bytes[i]);
+	}
+	return count;
+}
+
+static uint16_t tiny4koled_writeBlockP_tinyi2c(const uint8_t *bytes, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		TinyI2C.write(pgm_read_byte(&bytes[i]));
+	}
+	return count;
 }
 
 static void tiny4koled_begin_tinyi2c(void) {
@@ -52,9 +73,9 @@ static void tiny4koled_begin_tinyi2c(void) {
 }
 
 #ifndef TINY4KOLED_NO_PRINT
-SSD1306PrintDevice oled(&tiny4koled_begin_tinyi2c, &tiny4koled_beginTransmission_tinyi2c, &datacute_write_tinyi2c, &datacute_endTransmission_tinyi2c);
+SSD1306PrintDevice oled(&tiny4koled_begin_tinyi2c, &tiny4koled_beginTransmission_tinyi2c, &datacute_write_tinyi2c, &datacute_endTransmission_tinyi2c, &tiny4koled_repeat_tinyi2c, &tiny4koled_writeBlock_tinyi2c, &tiny4koled_writeBlockP_tinyi2c);
 #else
-SSD1306Device oled(&tiny4koled_begin_tinyi2c, &tiny4koled_beginTransmission_tinyi2c, &datacute_write_tinyi2c, &datacute_endTransmission_tinyi2c);
+SSD1306Device oled(&tiny4koled_begin_tinyi2c, &tiny4koled_beginTransmission_tinyi2c, &datacute_write_tinyi2c, &datacute_endTransmission_tinyi2c, &tiny4koled_repeat_tinyi2c, &tiny4koled_writeBlock_tinyi2c, &tiny4koled_writeBlockP_tinyi2c);
 #endif
 
 #endif
@@ -138,6 +138,17 @@ const uint16_t Tiny4kOLED_font6x8_widths_16s [] PROGMEM = {
   5+5+5+5+5+5+5+5+5+5+5+4+1+4+5
 };
 
+#ifdef TINY4KOLED_FONT_OFFSETS
+const uint16_t Tiny4kOLED_font6x8_offsets [] PROGMEM = {
+  0,5,6,9,14,19,24,29,31,34,37,42,47,49,54,56,
+  61,66,69,74,79,84,89,94,99,104,109,111,113,117,122,126,
+  131,136,141,146,151,156,161,166,171,176,179,184,189,194,199,204,
+  209,214,219,224,229,234,239,244,249,254,259,264,267,272,275,280,
+  285,288,293,298,303,308,313,318,323,328,331,335,339,342,347,352,
+  357,362,367,372,377,382,387,392,397,402,407,412,416,417,421
+};
+#endif
+
 const DCfont Tiny4kOLEDfont6x8 = {
   (uint8_t *)Tiny4kOLED_font6x8,
   0, // character width in pixels
@@ -145,7 +156,13 @@ const DCfont Tiny4kOLEDfont6x8 = {
   32,126, // ASCII extents
   (uint16_t *)Tiny4kOLED_font6x8_widths_16s,
   (uint8_t *)Tiny4kOLED_font6x8_widths,
-  1 // spacing
+  1, // spacing
+#ifdef TINY4KOLED_FONT_OFFSETS
+  (uint16_t *)Tiny4kOLED_font6x8_offsets,
+#else
+  0, // no offsets
+#endif
+  0 // not compressed
 };
 
 // for backwards compatibility
@@ -96,7 +96,9 @@ const DCfont TinyOLED4kfont8x16Caps = {
   8, // character width in pixels
   2, // character height in pages (8 pixels)
   32,95, // ASCII extents
-  0,0,0 // Unused for fixed width fonts
+  0,0,0, // Unused for fixed width fonts
+  0, // no offsets
+  0 // not compressed
   };
 
 // for backwards compatibility
@@ -233,6 +233,15 @@ const uint16_t Tiny4kOLED_font8x16_caps_widths_16s [] PROGMEM = {
   7+7+8+6+7+8+8+7+8+7+7+4+6+6+5+8
 };
 
+#ifdef TINY4KOLED_FONT_OFFSETS
+const uint16_t Tiny4kOLED_font8x16_caps_offsets [] PROGMEM = {
+  0,14,18,30,44,54,68,84,90,98,106,120,134,140,152,156,
+  170,182,192,204,216,228,240,252,264,276,288,292,296,308,322,334,
+  346,360,376,390,404,418,432,446,460,476,486,500,514,528,542,558,
+  572,586,600,616,628,642,658,674,688,704,718,732,740,752,764,774
+};
+#endif
+
 const DCfont Tiny4kOLEDfont8x16Caps = {
   (uint8_t *)Tiny4kOLED_font8x16_caps,
   0, // character width in pixels
@@ -240,7 +249,13 @@ const DCfont Tiny4kOLEDfont8x16Caps = {
   32,95, // ASCII extents
   (uint16_t *)Tiny4kOLED_font8x16_caps_widths_16s,
   (uint8_t *)Tiny4kOLED_font8x16_caps_widths,
-  1 // spacing
+  1, // spacing
+#ifdef TINY4KOLED_FONT_OFFSETS
+  (uint16_t *)Tiny4kOLED_font8x16_caps_offsets,
+#else
+  0, // no offsets
+#endif
+  0 // not compressed
   };
 
 // for backwards compatibility
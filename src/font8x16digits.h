@@ -42,7 +42,9 @@ const DCfont TinyOLED4kfont8x16Digits = {
   8, // character width in pixels
   2, // character height in pages (8 pixels)
   48,57, // ASCII extents
-  0,0,0 // Unused for fixed width fonts
+  0,0,0, // Unused for fixed width fonts
+  0, // no offsets
+  0 // not compressed
 };
 
 // for backwards compatibility
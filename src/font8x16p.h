@@ -328,6 +328,17 @@ const uint16_t Tiny4kOLED_font8x16_widths_16s [] PROGMEM = {
   7+7+7+6+5+8+8+8+6+8+6+4+1+4+7
 };
 
+#ifdef TINY4KOLED_FONT_OFFSETS
+const uint16_t Tiny4kOLED_font8x16_offsets [] PROGMEM = {
+  0,14,18,30,44,54,68,84,90,98,106,120,134,140,152,156,
+  170,182,192,204,216,228,240,252,264,276,288,292,296,308,322,334,
+  346,360,376,390,404,418,432,446,460,476,486,500,514,528,542,558,
+  572,586,600,616,628,642,658,674,688,704,718,732,740,752,764,774,
+  790,796,810,824,836,850,862,876,888,904,914,924,938,948,964,980,
+  992,1006,1020,1034,1046,1056,1072,1088,1104,1116,1132,1144,1152,1154,1162
+};
+#endif
+
 const DCfont Tiny4kOLEDfont8x16 = {
   (uint8_t *)Tiny4kOLED_font8x16,
   0, // character width in pixels
@@ -335,7 +346,13 @@ const DCfont Tiny4kOLEDfont8x16 = {
   32,126, // ASCII extents
   (uint16_t *)Tiny4kOLED_font8x16_widths_16s,
   (uint8_t *)Tiny4kOLED_font8x16_widths,
-  1 // spacing
+  1, // spacing
+#ifdef TINY4KOLED_FONT_OFFSETS
+  (uint16_t *)Tiny4kOLED_font8x16_offsets,
+#else
+  0, // no offsets
+#endif
+  0 // not compressed
   };
 
 // for backwards compatibility